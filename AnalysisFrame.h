@@ -0,0 +1,54 @@
+#ifndef _ANALYSIS_FRAME_H_
+#define _ANALYSIS_FRAME_H_
+
+/******************************************************************************
+
+One published result of the audio analysis
+
+AudioVisualizer fills in a frame for every block it analyses and publishes it
+by swapping it with the previous one, so the frame consumers read through
+getFrame() never changes under them until the next analysis runs. Consumers
+keep the sequence of the last frame they used and skip their per-frame work
+when it has not moved. The bass branch publishes less often; its fields carry
+over from frame to frame and bassSequence only moves when they change.
+
+Frames are sized by the analysis that fills them in: AudioVisualizer<FFT_SIZE,
+RATE>::Frame is AnalysisFrame<FFT_SIZE / 2>. Levels are Q15 whatever FFT
+size and arithmetic the analysis uses internally: smoothed and bass are
+normalised by the automatic gain, 32767 being the loudest bin lately, and that
+is what renderers draw. Onset fields describe the latest onset, which may be
+from an earlier frame; `onset` is only true for the frame it was found in.
+
+******************************************************************************/
+
+#include <arm_math.h>
+
+#include "constants.h"
+
+template<int BINS>
+struct AnalysisFrame {
+    uint32_t sequence;                      // 0 until the first frame is published
+    uint32_t time;                          // halMicros() when the block was taken
+
+    q15_t smoothed[BINS];                   // Levels less the noise floor, normalised, smoothed over frames
+
+    q15_t maximumValue;                     // Largest smoothed level this frame
+    uint32_t maximumIndex;
+    q15_t averageValue;                     // Mean smoothed level this frame
+    q15_t averageMaximumValue;              // Mean of recent frames' maximums
+    q15_t peakValue;                        // Largest maximum since initialize()
+    uint32_t peakIndex;
+
+    bool onset;
+    uint32_t onsetTime;
+    float32_t onsetStrength;                // Flux over the threshold, 1 just at it
+    uint8_t onsetBands;
+
+    q15_t bass[BASS_FFT_SAMPLES / 2];       // Bass branch levels less the noise floor, normalised
+    uint32_t bassSequence;                  // 0 until the first bass frame
+    uint32_t bassTime;                      // halMicros() of the block that completed it
+    uint16_t bassPeakFrequency;             // Strongest bass bin above DC, interpolated, in Hz * 16
+    q15_t bassPeakValue;
+};
+
+#endif
@@ -1,257 +1,655 @@
 /**
- *  Sampling frequency              ~14.4kHz
- *  Maximum frequency detectable    ~7.2kHz
- *  Frequency per bin               ~56Hz
+ *  Sampling frequency              RATE (~14.4kHz, see HalSamd.cpp)
+ *  Maximum frequency detectable    RATE / 2
+ *  Frequency per bin               RATE / FFT_SIZE (225Hz at 64, ~56Hz at 256)
+ *  New frame every                 SAMPLE_BLOCK samples (2.2ms at 64, 8.9ms at 256)
+ *
+ *  Bass branch, from the same blocks, decimated by BASS_DECIMATION (8):
+ *  Sampling frequency              RATE / 8 (1800Hz)
+ *  Frequency per bin               RATE / 8 / BASS_FFT_SAMPLES (~7Hz)
+ *  New frame every                 BASS_HOP * 8 samples (35.6ms)
  */
 
 #include <math.h>
 
 #include "AudioVisualizer.h"
+#include "Profile.h"
+#include "Window.h"
 
-#define WAIT_ADC_SYNC   while (ADC->STATUS.bit.SYNCBUSY) {}
-#define WAIT_ADC_RESET  while (ADC->CTRLA.bit.SWRST) {}
-
-#define ADC_CHANNEL             0x00
 #define SMOOTHING               0.55
-#define MICROPHONE_LOW          310
-#define MICROPHONE_MIDPOINT     1551
-#define MICROPHONE_HIGH         2793
-#define MAXIMUMS_TO_KEEP        64
-
-float32_t beatSamples[FFT_SAMPLES];
-float32_t samples[FFT_SAMPLES * 2];
-float32_t fftOutput[FFT_SAMPLES];
-float32_t fftEqualized[FFT_SAMPLES];
-float32_t fftSmoothed[FFT_SAMPLES / 2];
-float32_t windowOutput[FFT_SAMPLES];
-float32_t lastMaximums[MAXIMUMS_TO_KEEP];
-uint8_t lastMaximumsIndex = 0;
-volatile bool sampling = false;
-volatile int samplePosition = 0;
-float32_t lastMaximumValue;
-uint32_t lastMaximumIndex;
-float32_t maximumValue;
-uint32_t maximumIndex;
-float32_t averageValue;
-
-// Values to remove from bins to better normalize them
-const float32_t noise[64] = {
-    3.0, 2.6, 1.4, 1.1, 0.6, 0.4, 0.2, 0.2, 0.2, 0.1, 0.1, 0.1, 0.1, 0.1, 0.1, 0.1,
-    0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0,
-    0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0,
-    0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0
-};
-
-const float32_t eq[64]={
-    0.12, 0.12, 0.34, 0.40, 0.42, 0.48, 0.50, 0.54, 0.58, 0.62, 0.68, 0.74, 0.76, 0.88, 0.92, 1.00,
-    1.00, 1.00, 1.00, 1.00, 1.00, 1.00, 1.00, 1.00, 1.00, 1.00, 1.00, 1.00, 1.00, 1.00, 1.00, 1.00,
-    1.00, 1.00, 1.00, 1.00, 1.00, 1.00, 1.00, 1.00, 1.00, 1.00, 1.00, 1.00, 1.00, 1.00, 1.00, 1.00,
-    1.00, 1.00, 1.00, 1.00, 1.00, 1.00, 1.00, 1.00, 1.00, 1.00, 1.00, 1.00, 1.00, 1.00, 1.00, 1.00
-};
 
-void serialDebugFFT() {
-    for (int i = 0; i < 8; i++) {
-        Serial.print(fftEqualized[i]);
-        Serial.print("\t");
-    }
+// Levels come out in the units of a 64 point analysis whatever FFT_SIZE is
+// (AnalysisFrame.h), so thresholds need no retuning
+#define LEVEL_SCALE             (64.0 / FFT_SIZE)
+
+// Noise floors follow the quietest moments of the last NOISE_FLOOR_TIME ms
+// (NoiseFloor.h)
+#define NOISE_FLOOR_TIME        3000
+
+// Automatic gain: the envelope jumps to the loudest tilted bin and halves
+// every AGC_RELEASE ms after that, but never drops below AGC_MINIMUM
+// (magnitude units), so a quiet room isn't turned up into hiss. Normalised
+// levels are level / envelope, published in Q15.
+#define AGC_RELEASE             2000
+#define AGC_MINIMUM             1.0
+
+#ifdef SLIDING_DFT_ANALYSIS
+#define WINDOW_GAIN             1.0
+#else
+#define WINDOW_GAIN             windowGain(STFT_WINDOW)
+#endif
+
+#ifdef FIXED_POINT_ANALYSIS
+// arm_rfft_q15 returns X[k] / FFT_SIZE and complexMagnitudes() halves that
+// again (2.14 format), so one fixed point magnitude step is worth this much
+// (the window's loss of level is made up here rather than by clipping samples)
+#define FIXED_MAGNITUDE_UNIT    (FFT_SIZE * 2 / 32768.0 / WINDOW_GAIN * LEVEL_SCALE)
+#define SMOOTHING_Q15           ((q31_t)(SMOOTHING * 32768))
+#define AGC_MINIMUM_Q8          ((uint32_t)(AGC_MINIMUM / FIXED_MAGNITUDE_UNIT * 256 + 0.5))
+// Bass magnitude steps per main analysis step, in Q8
+#define BASS_STEP_Q8            ((uint32_t)(BASS_MAGNITUDE_UNIT / FIXED_MAGNITUDE_UNIT * 256 + 0.5))
+#endif
 
-    Serial.print("\n");
+/**
+ * Onset detection: half-wave rectified spectral flux, summed over each band
+ * group, against a threshold that follows the median flux of the last
+ * ONSET_HISTORY slots. A slot holds the largest flux of ONSET_DECIMATION
+ * frames, so the median covers a quarter of a second whatever the frame rate
+ * while only ever sorting a few numbers. The flux is taken from the equalized
+ * levels before smoothing, in whatever units the analysis path works in.
+ */
+#define ONSET_DECIMATION        (RATE / SAMPLE_BLOCK / 60)  // ~16ms of frames
+#define ONSET_REFRACTORY        100000  // us
+// Threshold is median * NUMERATOR / DENOMINATOR + ONSET_FLOOR
+#define ONSET_NUMERATOR         2
+#define ONSET_DENOMINATOR       1
+#define ONSET_FLOOR             ((onset_t)(0.5 / ONSET_UNIT))
+
+#ifdef FIXED_POINT_ANALYSIS
+#define ONSET_LEVELS            fixedEqualized
+#define ONSET_UNIT              FIXED_MAGNITUDE_UNIT
+#else
+#define ONSET_LEVELS            equalized
+#define ONSET_UNIT              1.0
+#endif
+
+// Bass, low mids, high mids, highs: lower edges in Hz, the last band runs to
+// the top of the analysed bins
+static constexpr uint16_t onsetBandFrequencies[ONSET_BANDS] = { 0, 450, 1350, 3150 };
+
+constexpr int frequencyBin(uint32_t frequency, int fftSize, int rate) {
+    return (frequency * fftSize + rate / 2) / rate;
 }
 
-void processingDebugFFT() {
-    Serial.write(255);
-    for (int i = 0; i < FFT_SAMPLES; i++) {
-        Serial.write((byte)(round((fftOutput[i] / maximumValue) * 254)));
-    }
+// Decimation low pass for the bass branch: Hann windowed sinc in Q15, cut
+// off at BASS_CUTOFF of the decimated Nyquist frequency. At 14.4kHz that is
+// 630Hz, and whatever folds back below ~700Hz is at least 40dB down.
+#define BASS_CUTOFF             0.7
+
+// Hann and the CMSIS Q15 FFT lose this much, made up by the bass gain
+#define BASS_MAGNITUDE_UNIT     (BASS_FFT_SAMPLES * 2 / 32768.0 / windowGain(STFT_WINDOW) * 64.0 / BASS_FFT_SAMPLES)
+
+// sin(x) / x for x >= 0
+constexpr double lowPassSinc(double x) {
+    return x < 1e-9 ? 1.0 : windowCos(x - WINDOW_PI / 2) / x;
 }
 
-AudioVisualizer::AudioVisualizer() {
-    for (int i = 0; i < FFT_SAMPLES; i++) {
-        windowOutput[i] = 0.5 - (0.5 * arm_cos_f32((2.0 * PI * i) / (FFT_SAMPLES / 2 - 1)));
-    }
+// Tap k for a cutoff given as a fraction of the input rate
+constexpr double lowPassTap(int k, double cutoff) {
+    return 2 * cutoff * windowShape(WINDOW_HANN, k + 1, BASS_TAPS + 1) *
+           lowPassSinc(2 * WINDOW_PI * cutoff * (k * 2 > BASS_TAPS - 1 ? k - (BASS_TAPS - 1) / 2.0 : (BASS_TAPS - 1) / 2.0 - k));
+}
 
-    maximumValue = 8;
+constexpr int16_t roundQ15(double value) {
+    return (int16_t)(value < 0 ? value * 32768 - 0.5 : value * 32768 + 0.5);
 }
 
-/**
- * Initialize the Timer clock so that we can take samples
- */
-void AudioVisualizer::initialize() {
-    lastMaximumValue = 0;
-    maximumValue = 0;
+template<int... I>
+constexpr WindowTable<int16_t, BASS_TAPS> makeLowPass(double cutoff, WindowIndices<I...>) {
+    return {{ roundQ15(lowPassTap(I, cutoff))... }};
+}
 
-    // Make sure to enable the ADC clock in power management
-    PM->APBCMASK.reg |= PM_APBCMASK_ADC;
+// Spectral tilt in place of a hand tuned eq: +3dB an octave (pink noise
+// compensation) up to TILT_REFERENCE Hz and flat above, so music's falling
+// spectrum doesn't leave everything to the bass
+#define TILT_REFERENCE          3400.0
 
-    // Enable the generic clock for ADC
-    GCLK->CLKCTRL.reg = GCLK_CLKCTRL_CLKEN | GCLK_CLKCTRL_GEN_GCLK0 | GCLK_CLKCTRL_ID(GCM_ADC);
-    while (GCLK->STATUS.bit.SYNCBUSY);
+template<int N>
+struct CurveTable {
+    float32_t values[N];
+};
 
-    resetADC();
-    initADC();
+// sqrt(x) for 0 <= x <= 1, by Newton's method from 1
+constexpr double tiltRoot(double x, double guess, int n) {
+    return n == 0 ? guess : tiltRoot(x, (guess + x / guess) / 2, n - 1);
 }
 
-float32_t AudioVisualizer::getDB(float32_t sample) {
-    return 20 * log10(abs(sample));
+constexpr float32_t tiltAt(double frequency) {
+    return frequency >= TILT_REFERENCE ? 1.0f : (float32_t)tiltRoot(frequency / TILT_REFERENCE, 1.0, 24);
 }
 
-float32_t AudioVisualizer::getAverageValue() {
-    return averageValue;
+template<int FFT_SIZE, int RATE, int... I>
+constexpr CurveTable<FFT_SIZE / 2> makeTiltTable(WindowIndices<I...>) {
+    return {{ tiltAt((I > 0 ? I : 0.5) * RATE / FFT_SIZE)... }};
 }
 
-float32_t AudioVisualizer::getAverageMaximumValue() {
-    float32_t average;
-    arm_mean_f32(lastMaximums, MAXIMUMS_TO_KEEP, &average);
-    return average;
+/**
+ * The tilt at the centre of each of the FFT_SIZE / 2 bins, or for the DC bin,
+ * which takes in the lowest bass, half a bin up
+ */
+template<int FFT_SIZE, int RATE>
+constexpr CurveTable<FFT_SIZE / 2> makeTilt() {
+    return makeTiltTable<FFT_SIZE, RATE>(typename MakeWindowIndices<FFT_SIZE / 2>::type());
 }
 
-uint32_t AudioVisualizer::getLastMaximumIndex() {
-    return lastMaximumIndex;
-}
+/**
+ * Everything an AudioVisualizer<FFT_SIZE, RATE> looks up, worked out by the
+ * compiler and kept in flash
+ */
+template<int FFT_SIZE, int RATE>
+struct AnalysisTables {
+    static constexpr CurveTable<FFT_SIZE / 2> tilt = makeTilt<FFT_SIZE, RATE>();
+
+    static constexpr WindowTable<int16_t, BASS_TAPS> bassFilter =
+        makeLowPass(BASS_CUTOFF / BASS_DECIMATION / 2, MakeWindowIndices<BASS_TAPS>::type());
+    // Same scale as the main Q15 window: decimated samples keep the units of
+    // (2 * count - LOW - HIGH)
+    static constexpr WindowTable<int16_t, BASS_FFT_SAMPLES> bassWindow =
+        makeWindow<int16_t, BASS_FFT_SAMPLES>(STFT_WINDOW, 32768.0 * 256 / (MICROPHONE_HIGH - MICROPHONE_LOW), true);
+
+#if defined(FIXED_POINT_ANALYSIS) && !defined(SLIDING_DFT_ANALYSIS)
+    // Window times the scale from (2 * count - LOW - HIGH) to Q15, in Q8 so the
+    // product stays in 32 bits; converting and windowing is one multiply
+    static constexpr WindowTable<int16_t, FFT_SIZE> window =
+        makeWindow<int16_t, FFT_SIZE>(STFT_WINDOW, 32768.0 * 256 / (MICROPHONE_HIGH - MICROPHONE_LOW), true);
+#elif !defined(FIXED_POINT_ANALYSIS)
+    // Window times the scale from (2 * count - LOW - HIGH) to -1..1, with the
+    // window's loss of level made up
+    static constexpr WindowTable<float32_t, FFT_SIZE> window =
+        makeWindow<float32_t, FFT_SIZE>(STFT_WINDOW, 1.0 / (MICROPHONE_HIGH - MICROPHONE_LOW) / WINDOW_GAIN * LEVEL_SCALE, false);
+#endif
+};
 
-float32_t AudioVisualizer::getLastMaximumValue() {
-    return lastMaximumValue;
-}
+template<int FFT_SIZE, int RATE>
+constexpr CurveTable<FFT_SIZE / 2> AnalysisTables<FFT_SIZE, RATE>::tilt;
+template<int FFT_SIZE, int RATE>
+constexpr WindowTable<int16_t, BASS_TAPS> AnalysisTables<FFT_SIZE, RATE>::bassFilter;
+template<int FFT_SIZE, int RATE>
+constexpr WindowTable<int16_t, BASS_FFT_SAMPLES> AnalysisTables<FFT_SIZE, RATE>::bassWindow;
+#if defined(FIXED_POINT_ANALYSIS) && !defined(SLIDING_DFT_ANALYSIS)
+template<int FFT_SIZE, int RATE>
+constexpr WindowTable<int16_t, FFT_SIZE> AnalysisTables<FFT_SIZE, RATE>::window;
+#elif !defined(FIXED_POINT_ANALYSIS)
+template<int FFT_SIZE, int RATE>
+constexpr WindowTable<float32_t, FFT_SIZE> AnalysisTables<FFT_SIZE, RATE>::window;
+#endif
 
-uint32_t AudioVisualizer::getMaximumIndex() {
-    return maximumIndex;
-}
+/**
+ * The CMSIS complex FFT instance, twiddles and bit reversal table for N points
+ */
+template<int N>
+struct CfftTable {
+    static_assert(N < 0, "No arm_cfft_sR_f32 table for this FFT size");
+};
+
+#define CFFT_TABLE(N) \
+    template<> struct CfftTable<N> { \
+        static const arm_cfft_instance_f32 *get() { return &arm_cfft_sR_f32_len##N; } \
+    }
 
-float32_t AudioVisualizer::getMaximumValue() {
-    return maximumValue;
+CFFT_TABLE(32);
+CFFT_TABLE(64);
+CFFT_TABLE(128);
+CFFT_TABLE(256);
+
+template<int FFT_SIZE, int RATE>
+AudioVisualizer<FFT_SIZE, RATE>::AudioVisualizer() {
+    static_assert(frequencyBin(onsetBandFrequencies[ONSET_BANDS - 1], FFT_SIZE, RATE) < analysisBins,
+                  "Onset bands need more analysis bins");
+
+    memset(frames, 0, sizeof(frames));
+    publishedFrame = 0;
+    frameSequence = 0;
+    maximumValue = 0;
+#ifdef FIXED_POINT_ANALYSIS
+    envelope = AGC_MINIMUM_Q8;
+    agcRelease = (uint32_t)(pow(0.5, SAMPLE_BLOCK * 1000.0 / ((double)RATE * AGC_RELEASE)) * 4294967296.0);
+#else
+    envelope = AGC_MINIMUM;
+    agcRelease = pow(0.5, SAMPLE_BLOCK * 1000.0 / ((double)RATE * AGC_RELEASE));
+    memset(smoothed, 0, sizeof(smoothed));
+#endif
+    bassGain = 0;
+    noiseFloor.begin((uint32_t)RATE * NOISE_FLOOR_TIME / 1000 / SAMPLE_BLOCK / NOISE_FLOOR_WINDOWS);
+
+#ifndef SLIDING_DFT_ANALYSIS
+    memset(history, 0, sizeof(history));
+    historyIndex = 0;
+#endif
+
+#if defined(FIXED_POINT_ANALYSIS) && !defined(SLIDING_DFT_ANALYSIS)
+    arm_rfft_init_q15(&rfft, FFT_SIZE, 0, 1);
+#endif
+
+#ifdef FIXED_POINT_ANALYSIS
+    // Only done once at boot, the per frame work stays in integers
+    typedef AnalysisTables<FFT_SIZE, RATE> Tables;
+    for (int i = 0; i < FFT_SIZE / 2; i++) {
+        fixedTilt[i] = (uint16_t)(Tables::tilt.values[i] * 32768 + 0.5f);
+    }
+#endif
+
+    for (int b = 0; b < ONSET_BANDS; b++) {
+        onsetBandEdges[b] = frequencyBin(onsetBandFrequencies[b], FFT_SIZE, RATE);
+        onsetSlot[b] = 0;
+        onsetMedian[b] = 0;
+    }
+    onsetBandEdges[ONSET_BANDS] = analysisBins;
+    memset(onsetPrevious, 0, sizeof(onsetPrevious));
+    memset(onsetHistory, 0, sizeof(onsetHistory));
+    onsetHistoryIndex = 0;
+    onsetFrames = 0;
+    onsetBands = 0;
+    onsetAbove = false;
+    onset = false;
+    onsetTime = 0;
+    onsetStrength = 0;
+
+    memset(bassTaps, 0, sizeof(bassTaps));
+    memset(bassHistory, 0, sizeof(bassHistory));
+    bassTapIndex = 0;
+    bassPhase = 0;
+    bassHistoryIndex = 0;
+    bassHopCount = 0;
+    bassPending = false;
+    bassCopies = 0;
+    bassSequence = 0;
+    arm_rfft_init_q15(&bassRfft, BASS_FFT_SAMPLES, 0, 1);
+    bassFloor.begin((uint32_t)RATE * NOISE_FLOOR_TIME / 1000 / (BASS_HOP * BASS_DECIMATION) / NOISE_FLOOR_WINDOWS);
 }
 
-float32_t* AudioVisualizer::getOutput() {
-    return fftOutput;
+/**
+ * Start the sample source so that we can take samples
+ */
+template<int FFT_SIZE, int RATE>
+void AudioVisualizer<FFT_SIZE, RATE>::initialize() {
+    maximumValue = 0;
+    maximumIndex = 0;
+#ifdef SLIDING_DFT_ANALYSIS
+    lastOverruns = 0;
+#endif
+
+    halSampleBegin();
 }
 
-float32_t* AudioVisualizer::getEqualizedOutput() {
-    return fftEqualized;
+template<int FFT_SIZE, int RATE>
+float32_t AudioVisualizer<FFT_SIZE, RATE>::getDB(float32_t sample) {
+    return 20 * log10(abs(sample));
 }
 
-float32_t* AudioVisualizer::getSmoothedOutput() {
-    return fftSmoothed;
+template<int FFT_SIZE, int RATE>
+const typename AudioVisualizer<FFT_SIZE, RATE>::Frame& AudioVisualizer<FFT_SIZE, RATE>::getFrame() const {
+    return frames[publishedFrame];
 }
 
-void AudioVisualizer::loop() {
-    if (sampling) {
-        return;
+#ifdef FIXED_POINT_ANALYSIS
+/**
+ * Move the AGC envelope on by a frame whose loudest equalized level is
+ * `loudest`, in magnitude steps, and return the gain that normalises it: a
+ * Q15 level per step in Q8. That is at most 2^16 as long as AGC_MINIMUM is at
+ * least 128 steps, and clamped under it so the products fit 32 bits.
+ */
+template<int FFT_SIZE, int RATE>
+uint32_t AudioVisualizer<FFT_SIZE, RATE>::updateGain(q15_t loudest) {
+    uint32_t released = ((uint64_t)envelope * agcRelease) >> 32;
+    envelope = max((uint32_t)loudest << 8, max(AGC_MINIMUM_Q8, released));
+    return min(65535u, (1u << 31) / envelope);
+}
+#else
+/**
+ * Move the AGC envelope on by a frame whose loudest equalized level is
+ * `loudest`, in magnitude units, and return the gain that normalises it
+ */
+template<int FFT_SIZE, int RATE>
+float32_t AudioVisualizer<FFT_SIZE, RATE>::updateGain(float32_t loudest) {
+    envelope = max(loudest, max((float32_t)AGC_MINIMUM, envelope * agcRelease));
+    return 1 / envelope;
+}
+#endif
+
+template<typename T>
+static void sortOnsetHistory(T *sorted, const T *history) {
+    for (int i = 0; i < ONSET_HISTORY; i++) {
+        T value = history[i];
+        int j = i;
+        for (; j > 0 && sorted[j - 1] > value; j--) {
+            sorted[j] = sorted[j - 1];
+        }
+        sorted[j] = value;
     }
+}
 
-    //window(samples);
-    arm_cfft_f32(&arm_cfft_sR_f32_len64, samples, 0, 1);
-    arm_cmplx_mag_f32(samples, fftOutput, FFT_SAMPLES);
+/**
+ * Run once per analysis frame, after the equalized levels are in
+ */
+template<int FFT_SIZE, int RATE>
+void AudioVisualizer<FFT_SIZE, RATE>::detectOnset(uint32_t now) {
+    float32_t strength = 0;
+    uint8_t bands = 0;
+    bool slotDone = ++onsetFrames >= ONSET_DECIMATION;
+
+    for (int b = 0; b < ONSET_BANDS; b++) {
+        onset_t flux = 0;
+        for (int i = onsetBandEdges[b]; i < onsetBandEdges[b + 1]; i++) {
+            if (ONSET_LEVELS[i] > onsetPrevious[i]) {
+                flux += ONSET_LEVELS[i] - onsetPrevious[i];
+            }
+            onsetPrevious[i] = ONSET_LEVELS[i];
+        }
+
+        onset_t threshold = onsetMedian[b] * ONSET_NUMERATOR / ONSET_DENOMINATOR + ONSET_FLOOR;
+        if (flux > threshold) {
+            bands |= 1 << b;
+            strength = max(strength, (float32_t)flux / (float32_t)threshold);
+        }
+
+        if (flux > onsetSlot[b]) {
+            onsetSlot[b] = flux;
+        }
+
+        if (slotDone) {
+            onset_t sorted[ONSET_HISTORY];
+            onsetHistory[b][onsetHistoryIndex] = onsetSlot[b];
+            onsetSlot[b] = 0;
+            sortOnsetHistory(sorted, onsetHistory[b]);
+            onsetMedian[b] = (sorted[ONSET_HISTORY / 2 - 1] + sorted[ONSET_HISTORY / 2]) / 2;
+        }
+    }
 
-    sampling = true;
-    samplePosition = 0;
-    NVIC_EnableIRQ(ADC_IRQn);
+    if (slotDone) {
+        onsetFrames = 0;
+        onsetHistoryIndex = (onsetHistoryIndex + 1) % ONSET_HISTORY;
+    }
 
-    for (int i = 0; i < FFT_SAMPLES / 2; i++) {
-        fftOutput[i] = fftOutput[i] < noise[i] ? 0 : fftOutput[i] - noise[i];
-        fftEqualized[i] = fftOutput[i] * eq[i];
-        fftSmoothed[i] = max(fftEqualized[i], SMOOTHING * fftSmoothed[i] + ((1 - SMOOTHING) * fftEqualized[i]));
+    // Only the frame the flux crosses the threshold counts, and not too soon after the last one
+    onset = bands != 0 && !onsetAbove && now - onsetTime >= ONSET_REFRACTORY;
+    onsetAbove = bands != 0;
+    if (onset) {
+        onsetTime = now;
+        onsetStrength = strength;
+        onsetBands = bands;
     }
+}
 
-    lastMaximumValue = 0;
-    lastMaximumIndex = 0;
-    arm_max_f32(fftSmoothed, FFT_SAMPLES / 2, &lastMaximumValue, &lastMaximumIndex);
-    arm_mean_f32(fftSmoothed, FFT_SAMPLES / 2, &averageValue);
+/**
+ * Low pass filter and decimate a captured block into the bass history. Every
+ * BASS_HOP decimated samples leave a bass FFT pending for analyseBass().
+ */
+template<int FFT_SIZE, int RATE>
+void AudioVisualizer<FFT_SIZE, RATE>::decimateBass(const volatile uint16_t *rawSamples, uint16_t count) {
+    typedef AnalysisTables<FFT_SIZE, RATE> Tables;
+
+    for (uint16_t i = 0; i < count; i++) {
+        int16_t value = rawSamples[i] * 2 - (MICROPHONE_LOW + MICROPHONE_HIGH);
+        bassTaps[bassTapIndex] = value;
+        bassTaps[bassTapIndex + BASS_TAPS] = value;
+        if (++bassTapIndex >= BASS_TAPS) {
+            bassTapIndex = 0;
+        }
+
+        // The filter only runs for the samples that are kept
+        if (++bassPhase < BASS_DECIMATION) {
+            continue;
+        }
+        bassPhase = 0;
+
+        const int16_t *taps = bassTaps + bassTapIndex;
+        int32_t sum = 0;
+        for (int k = 0; k < BASS_TAPS; k++) {
+            sum += taps[k] * Tables::bassFilter.values[k];
+        }
+
+        bassHistory[bassHistoryIndex] = (int16_t)((sum + (1 << 14)) >> 15);
+        bassHistoryIndex = (bassHistoryIndex + 1) & (BASS_FFT_SAMPLES - 1);
+        if (++bassHopCount >= BASS_HOP) {
+            bassHopCount = 0;
+            bassPending = true;
+        }
+    }
+}
 
-    lastMaximums[lastMaximumsIndex] = lastMaximumValue;
-    lastMaximumsIndex++;
-    if (lastMaximumsIndex >= MAXIMUMS_TO_KEEP) {
-        lastMaximumsIndex = 0;
+/**
+ * Run the bass FFT into `frame` if a hop is pending, otherwise carry the bass
+ * fields over from `previous`. Needs bassGain from the frame's AGC.
+ */
+template<int FFT_SIZE, int RATE>
+void AudioVisualizer<FFT_SIZE, RATE>::analyseBass(Frame &frame, const Frame &previous) {
+    typedef AnalysisTables<FFT_SIZE, RATE> Tables;
+
+    if (!bassPending) {
+        // Once both frames hold the latest bass frame there is nothing to copy
+        if (bassCopies > 0) {
+            bassCopies--;
+            memcpy(frame.bass, previous.bass, sizeof(frame.bass));
+            frame.bassSequence = previous.bassSequence;
+            frame.bassTime = previous.bassTime;
+            frame.bassPeakFrequency = previous.bassPeakFrequency;
+            frame.bassPeakValue = previous.bassPeakValue;
+        }
+        return;
     }
+    bassPending = false;
+    bassCopies = 1;
 
-    //serialDebugFFT();
+    for (int i = 0; i < BASS_FFT_SAMPLES; i++) {
+        int32_t value = (bassHistory[(bassHistoryIndex + i) & (BASS_FFT_SAMPLES - 1)] * Tables::bassWindow.values[i]) >> 8;
+        bassSamples[i] = (q15_t)(value > 32767 ? 32767 : (value < -32768 ? -32768 : value));
+    }
 
-    if (lastMaximumValue > maximumValue) {
-        maximumValue = lastMaximumValue;
-        maximumIndex = lastMaximumIndex;
+    arm_rfft_q15(&bassRfft, bassSamples, bassSpectrum);
+    complexMagnitudes(bassSpectrum, bassMagnitude, BASS_FFT_SAMPLES / 2);
+
+    bassFloor.update(bassMagnitude);
+
+    // Normalised by the main analysis' gain, without the tilt
+    int peak = 1;
+    for (int i = 0; i < BASS_FFT_SAMPLES / 2; i++) {
+        q31_t noise = bassFloor.floor(i);
+        uint32_t level = bassMagnitude[i] < noise ? 0 : bassMagnitude[i] - noise;
+        uint32_t scaled = (level * bassGain + 128) >> 8;
+        frame.bass[i] = scaled > 32767 ? 32767 : scaled;
+        if (i > 1 && frame.bass[i] > frame.bass[peak]) {
+            peak = i;
+        }
     }
-}
 
-void disableADC() {
-    ADC->CTRLA.bit.ENABLE = 0;
-    WAIT_ADC_SYNC;
+    // A parabola through the peak and its neighbours puts it between bins,
+    // offset in Q8 of a bin
+    int32_t offset = 0;
+    if (peak < BASS_FFT_SAMPLES / 2 - 1) {
+        int32_t below = frame.bass[peak - 1];
+        int32_t above = frame.bass[peak + 1];
+        int32_t curvature = below - 2 * frame.bass[peak] + above;
+        if (curvature < 0) {
+            offset = 128 * (below - above) / curvature;
+        }
+    }
 
-    NVIC_ClearPendingIRQ(ADC_IRQn);
-    NVIC_DisableIRQ(ADC_IRQn);
+    // Hz * 16; a Q8 bin times bassRate * 16 stays under 2^30
+    frame.bassPeakFrequency = ((uint32_t)(peak * 256 + offset) * bassRate * 16 / BASS_FFT_SAMPLES + 128) >> 8;
+    frame.bassPeakValue = frame.bass[peak];
+    frame.bassTime = frame.time;
+    frame.bassSequence = ++bassSequence;
 }
 
-void initADC() {
-    sampling = true;
-    samplePosition = 0;
+template<int FFT_SIZE, int RATE>
+bool AudioVisualizer<FFT_SIZE, RATE>::loop() {
+    const volatile uint16_t *rawSamples = halSampleAvailable();
+    if (rawSamples == NULL) {
+        return false;
+    }
 
-    ADC->CTRLA.bit.ENABLE = 0;          // Disable ADC
-    WAIT_ADC_SYNC;
+    uint32_t stageStart = profileStart();
+    Frame &frame = frames[publishedFrame ^ 1];
+    frame.time = halMicros();
+
+#if defined(SLIDING_DFT_ANALYSIS)
+    // A dropped block leaves a gap the damping would take seconds to forget;
+    // starting over, the bins are only short of a full window for N samples
+    uint32_t overruns = halSampleOverruns();
+    if (overruns != lastOverruns) {
+        lastOverruns = overruns;
+        slidingDFT.reset();
+    }
 
-    // Set external voltage reference to AREF pin
-    ADC->REFCTRL.bit.REFSEL = ADC_REFCTRL_REFSEL_AREFA_Val;
-    WAIT_ADC_SYNC;
+    // Every sample of the hop moves the tracked bins along by one
+    slidingDFT.update(rawSamples, SAMPLE_BLOCK);
+
+    decimateBass(rawSamples, SAMPLE_BLOCK);
+    halSampleRelease();
+    profileEnd(PROFILE_CAPTURE, stageStart);
+    stageStart = profileStart();
+
+    // The spectrum is where the fft stage starts, also timed on its own
+    slidingDFT.getMagnitudes(fixedMagnitude);
+    profileEnd(PROFILE_SPECTRUM, stageStart);
+#else
+    // Slide the new block into the history, so the DMA buffer can go straight back
+    for (int i = 0; i < SAMPLE_BLOCK; i++) {
+        history[historyIndex] = rawSamples[i];
+        historyIndex = (historyIndex + 1) & (FFT_SIZE - 1);
+    }
 
-    // Set the clock prescaler (48MHz / 256 / 13(cycles per conversion) = ~14.4kHz)
-    // Set 12bit resolution
-    // Set free running mode (a new conversion will begin as a previous one completes)
-    ADC->CTRLB.reg = ADC_CTRLB_PRESCALER_DIV512 | ADC_CTRLB_RESSEL_12BIT | ADC_CTRLB_FREERUN;
-    WAIT_ADC_SYNC;
+    decimateBass(rawSamples, SAMPLE_BLOCK);
+    halSampleRelease();
+    profileEnd(PROFILE_CAPTURE, stageStart);
+    stageStart = profileStart();
+#endif
+
+#if defined(FIXED_POINT_ANALYSIS) && !defined(SLIDING_DFT_ANALYSIS)
+    // Map the raw ADC counts, oldest first, to windowed microphone values in Q15
+    typedef AnalysisTables<FFT_SIZE, RATE> Tables;
+    for (int i = 0; i < FFT_SIZE; i++) {
+        int32_t count = history[(historyIndex + i) & (FFT_SIZE - 1)];
+        int32_t value = ((count * 2 - (MICROPHONE_LOW + MICROPHONE_HIGH)) * Tables::window.values[i]) >> 8;
+        fixedSamples[i] = (q15_t)(value > 32767 ? 32767 : (value < -32768 ? -32768 : value));
+    }
 
-    // Enable Result Ready Interrupt
-    ADC->INTENSET.bit.RESRDY = 1;
-    WAIT_ADC_SYNC;
+    arm_rfft_q15(&rfft, fixedSamples, fixedSpectrum);
+    complexMagnitudes(fixedSpectrum, fixedMagnitude, FFT_SIZE / 2);
+    // The spectrum is where the fft stage starts, also timed on its own
+    profileEnd(PROFILE_SPECTRUM, stageStart);
+#endif
+
+#ifdef FIXED_POINT_ANALYSIS
+    noiseFloor.update(fixedMagnitude);
+
+    // Floor and tilt first: the gain depends on the loudest result
+    q31_t loudest = 0;
+    for (int i = 0; i < analysisBins; i++) {
+        q31_t noise = noiseFloor.floor(i);
+        q31_t output = fixedMagnitude[i] < noise ? 0 : fixedMagnitude[i] - noise;
+        q31_t equalized = (output * fixedTilt[i] + (1 << 14)) >> 15;
+        fixedEqualized[i] = equalized;
+        loudest = max(loudest, equalized);
+    }
 
-    // Set input to read from ADC_CHANNEL and Ground
-    ADC->INPUTCTRL.reg = ADC_CHANNEL | ADC_INPUTCTRL_MUXNEG_GND | ADC_INPUTCTRL_GAIN_1X;
-    WAIT_ADC_SYNC;
+    uint32_t gain = updateGain(loudest);
+    bassGain = min(65535u, (gain * BASS_STEP_Q8 + 128) >> 8);
+
+    // Smoothing carries on from the published frame
+    const Frame &previous = frames[publishedFrame];
+    q31_t sum = 0;
+    q31_t maximum = -1;
+    frame.maximumIndex = 0;
+
+    for (int i = 0; i < analysisBins; i++) {
+        uint32_t scaled = ((uint32_t)fixedEqualized[i] * gain + 128) >> 8;
+        q31_t normalized = scaled > 32767 ? 32767 : scaled;
+        q31_t smoothed = (SMOOTHING_Q15 * previous.smoothed[i] + (32768 - SMOOTHING_Q15) * normalized + (1 << 14)) >> 15;
+        frame.smoothed[i] = max(normalized, smoothed);
+
+        if (frame.smoothed[i] > maximum) {
+            maximum = frame.smoothed[i];
+            frame.maximumIndex = i;
+        }
+        sum += frame.smoothed[i];
+    }
 
-    ADC->CTRLA.bit.ENABLE = 1;
-    WAIT_ADC_SYNC;
+    frame.maximumValue = maximum;
+    frame.averageValue = sum / analysisBins;
+#else
+    // Map the raw ADC counts, oldest first, to windowed microphone values
+    typedef AnalysisTables<FFT_SIZE, RATE> Tables;
+    for (int i = 0; i < FFT_SIZE; i++) {
+        int32_t count = history[(historyIndex + i) & (FFT_SIZE - 1)];
+        samples[i * 2] = (count * 2 - (MICROPHONE_LOW + MICROPHONE_HIGH)) * Tables::window.values[i];
+        // Odd values are complex, set to 0
+        samples[i * 2 + 1] = 0;
+    }
 
-    NVIC_EnableIRQ(ADC_IRQn);
-}
+    arm_cfft_f32(CfftTable<FFT_SIZE>::get(), samples, 0, 1);
+    arm_cmplx_mag_f32(samples, fftOutput, FFT_SIZE);
+    profileEnd(PROFILE_SPECTRUM, stageStart);
 
-void resetADC() {
-    WAIT_ADC_SYNC;
+    noiseFloor.update(fftOutput);
 
-    ADC->CTRLA.bit.ENABLE = 0;          // Disable ADC
-    WAIT_ADC_SYNC;
+    // Floor and tilt first: the gain depends on the loudest result
+    float32_t loudest = 0;
+    for (int i = 0; i < FFT_SIZE / 2; i++) {
+        float32_t noise = noiseFloor.floor(i);
+        float32_t output = fftOutput[i] < noise ? 0 : fftOutput[i] - noise;
+        equalized[i] = output * Tables::tilt.values[i];
+        loudest = max(loudest, equalized[i]);
+    }
 
-    ADC->CTRLA.bit.SWRST = 1;           // Reset ADC
-    WAIT_ADC_SYNC;
-    WAIT_ADC_RESET;
-}
+    float32_t gain = updateGain(loudest);
+    bassGain = min(65535u, (uint32_t)(gain * BASS_MAGNITUDE_UNIT * 32768 * 256 + 0.5f));
 
-void window(float32_t *samples) {
-    for (int i = 0; i < FFT_SAMPLES; i += 2) {
-        samples[i] *= windowOutput[i / 2];
-    }
-}
+    // Smoothed in floats, published in Q15
+    q31_t sum = 0;
+    q31_t maximum = -1;
+    frame.maximumIndex = 0;
 
-void ADC_Handler(void) {
-    if (!sampling || samplePosition >= FFT_SAMPLES) {
-        ADC->INTFLAG.reg = ADC_INTFLAG_RESRDY;
-        WAIT_ADC_SYNC;
+    for (int i = 0; i < FFT_SIZE / 2; i++) {
+        float32_t normalized = min(1.0f, equalized[i] * gain);
+        smoothed[i] = max(normalized, SMOOTHING * smoothed[i] + ((1 - SMOOTHING) * normalized));
+        frame.smoothed[i] = (q15_t)(smoothed[i] * 32767 + 0.5f);
 
-        return;
+        if (frame.smoothed[i] > maximum) {
+            maximum = frame.smoothed[i];
+            frame.maximumIndex = i;
+        }
+        sum += frame.smoothed[i];
     }
 
-    // Read the value from the result register, then map the resulting value to the
-    // expected microphone values
-    // Microphone has DC bias of 1.25V and 2Vpp. VCC is 3.3V, reading is 12b (so 0-4095)
-    float32_t value = (float32_t)ADC->RESULT.reg;
+    frame.maximumValue = maximum;
+    frame.averageValue = sum / analysisBins;
+#endif
 
-    value = (value - MICROPHONE_LOW) * (2) / (MICROPHONE_HIGH - MICROPHONE_LOW) - 1;
+    detectOnset(frame.time);
 
-    samples[samplePosition * 2] = value;
-    // Odd values are complex, set to 0
-    samples[samplePosition * 2 + 1] = 0;
+    lastMaximums.push(frame.maximumValue);
 
-    if (++samplePosition >= FFT_SAMPLES) {
-        sampling = false;
-        NVIC_ClearPendingIRQ(ADC_IRQn);
-        NVIC_DisableIRQ(ADC_IRQn);
+    if (frame.maximumValue > maximumValue) {
+        maximumValue = frame.maximumValue;
+        maximumIndex = frame.maximumIndex;
     }
 
-    ADC->INTFLAG.reg = ADC_INTFLAG_RESRDY;
-    WAIT_ADC_SYNC;
+    frame.averageMaximumValue = (int32_t)lastMaximums.sum() / lastMaximums.size();
+    frame.peakValue = maximumValue;
+    frame.peakIndex = maximumIndex;
+    frame.onset = onset;
+    frame.onsetTime = onsetTime;
+    frame.onsetStrength = onsetStrength;
+    frame.onsetBands = onsetBands;
+    frame.sequence = ++frameSequence;
+
+    analyseBass(frame, frames[publishedFrame]);
+
+    publishedFrame ^= 1;
+    profileEnd(PROFILE_FFT, stageStart);
+    return true;
 }
+
+template class AudioVisualizer<FFT_SAMPLES, SAMPLE_RATE>;
@@ -1,34 +1,184 @@
 #ifndef _AUDIO_VISUALIZER_H_
 #define _AUDIO_VISUALIZER_H_
 
+/******************************************************************************
+
+Audio analysis, templated on FFT length and sample rate
+
+AudioVisualizer<FFT_SIZE, RATE> picks its buffers, window, spectral tilt
+and CMSIS tables for that size at compile time. A longer FFT gives
+finer bins (RATE / FFT_SIZE Hz each) at the cost of latency and RAM; the
+build's analysis is Visualizer, set by FFT_SAMPLES and SAMPLE_RATE in
+constants.h, and the member functions are only instantiated for that one
+(AudioVisualizer.cpp).
+
+******************************************************************************/
+
 #define ARM_MATH_CM0
 #include <Arduino.h>
 #include <arm_math.h>
 #include <arm_const_structs.h>
 
+#include "AnalysisFrame.h"
 #include "constants.h"
+#include "FixedPoint.h"
+#include "Hal.h"
+#include "RingBuffer.h"
+#include "NoiseFloor.h"
+#include "SlidingDFT.h"
+
+#if defined(SLIDING_DFT_ANALYSIS) && !defined(FIXED_POINT_ANALYSIS)
+#error "SLIDING_DFT_ANALYSIS needs FIXED_POINT_ANALYSIS"
+#endif
+
+// Frames of maximums averaged into averageMaximumValue cover this many ms
+#define MAXIMUMS_WINDOW         142
+
+#define ONSET_BANDS             4
+#define ONSET_HISTORY           16
 
-void disableADC();
-void initADC();
-void resetADC();
-void window(float32_t *samples);
+// Taps of the bass branch's decimation low pass
+#define BASS_TAPS               96
 
+template<int FFT_SIZE, int RATE>
 class AudioVisualizer {
+    // Sizes with CMSIS tables (arm_rfft_q15, arm_cfft_sR_f32_lenN) that
+    // still leave the displays room in 32KB of RAM
+    static_assert(FFT_SIZE >= 32 && FFT_SIZE <= 256 && (FFT_SIZE & (FFT_SIZE - 1)) == 0,
+                  "FFT size has to be a power of two from 32 to 256");
+    static_assert(RATE == SAMPLE_RATE, "The sample source captures at SAMPLE_RATE");
+    static_assert(SAMPLE_BLOCK <= FFT_SIZE, "Sample blocks are longer than the FFT");
+    static_assert(RATE % BASS_DECIMATION == 0, "The bass branch needs a whole decimated rate");
+    static_assert((BASS_FFT_SAMPLES & (BASS_FFT_SAMPLES - 1)) == 0 && BASS_HOP <= BASS_FFT_SAMPLES,
+                  "Bass FFT size has to be a power of two, the hop no longer");
+
 public:
+    static const int fftSize = FFT_SIZE;
+    static const int sampleRate = RATE;
+
+    // Spectrum bins the analysis fills in; bins past SLIDING_DFT_BINS are
+    // never computed by the sliding DFT and stay at 0
+#ifdef SLIDING_DFT_ANALYSIS
+    static const int analysisBins = SLIDING_DFT_BINS;
+#else
+    static const int analysisBins = FFT_SIZE / 2;
+#endif
+
+    // Bass branch: bassBins bins of bassRate / BASS_FFT_SAMPLES Hz each
+    static const int bassRate = RATE / BASS_DECIMATION;
+    static const int bassBins = BASS_FFT_SAMPLES / 2;
+
+    typedef AnalysisFrame<FFT_SIZE / 2> Frame;
+
     AudioVisualizer();
 
     void initialize();
-    void loop();
+    // Analyses a block if one has been captured; false if there was none
+    bool loop();
     float32_t getDB(float32_t sample);
-    float32_t getAverageValue();
-    float32_t getAverageMaximumValue();
-    float32_t getLastMaximumValue();
-    uint32_t getLastMaximumIndex();
-    uint32_t getMaximumIndex();
-    float32_t getMaximumValue();
-    float32_t* getEqualizedOutput();
-    float32_t* getOutput();
-    float32_t* getSmoothedOutput();
+
+    // Latest published analysis frame, see AnalysisFrame.h. The reference
+    // stays valid; its contents change when loop() publishes the next frame.
+    const Frame& getFrame() const;
+
+private:
+#ifdef FIXED_POINT_ANALYSIS
+    typedef q15_t level_t;
+    typedef q31_t onset_t;
+    typedef uint32_t gain_t;
+#else
+    typedef float32_t level_t;
+    typedef float32_t onset_t;
+    typedef float32_t gain_t;
+#endif
+
+    // Published frame and the one being filled in, swapped at the end of loop()
+    Frame frames[2];
+    uint8_t publishedFrame;
+    uint32_t frameSequence;
+    // Sums of squares of Q15 maximums need more than 32 bits
+    RingBuffer<q15_t, ((uint32_t)RATE * MAXIMUMS_WINDOW / SAMPLE_BLOCK + 500) / 1000, int64_t> lastMaximums;
+    q15_t maximumValue;
+    uint32_t maximumIndex;
+
+    // Magnitudes less their adaptive floor are scaled to Q15 levels by the
+    // AGC, see updateGain(); bassGain is the same gain for the bass branch's
+    // magnitudes, a Q15 level per step in Q8
+    NoiseFloor<level_t, analysisBins> noiseFloor;
+#ifdef FIXED_POINT_ANALYSIS
+    uint32_t envelope;                  // Magnitude steps in Q8
+    uint32_t agcRelease;                // Q32
+#else
+    float32_t envelope;
+    float32_t agcRelease;
+#endif
+    uint32_t bassGain;
+
+#ifndef SLIDING_DFT_ANALYSIS
+    // The last FFT_SIZE raw counts; each block replaces the oldest SAMPLE_BLOCK
+    uint16_t history[FFT_SIZE];
+    uint16_t historyIndex;
+#endif
+
+#ifdef FIXED_POINT_ANALYSIS
+#ifdef SLIDING_DFT_ANALYSIS
+    SlidingDFT<FFT_SIZE> slidingDFT;
+    uint32_t lastOverruns;              // halSampleOverruns() as of the last block
+#else
+    arm_rfft_instance_q15 rfft;
+    q15_t fixedSamples[FFT_SIZE];
+    q15_t fixedSpectrum[FFT_SIZE * 2];
+#endif
+    q15_t fixedMagnitude[FFT_SIZE];
+    q15_t fixedEqualized[FFT_SIZE / 2];
+    uint16_t fixedTilt[FFT_SIZE / 2];
+#else
+    float32_t samples[FFT_SIZE * 2];
+    float32_t fftOutput[FFT_SIZE];
+    // Levels as floats until they are published as Q15
+    float32_t equalized[FFT_SIZE / 2];
+    float32_t smoothed[FFT_SIZE / 2];
+#endif
+
+    // Onset detection state, see detectOnset()
+    uint16_t onsetBandEdges[ONSET_BANDS + 1];
+    onset_t onsetPrevious[analysisBins];
+    onset_t onsetHistory[ONSET_BANDS][ONSET_HISTORY];
+    onset_t onsetSlot[ONSET_BANDS];
+    onset_t onsetMedian[ONSET_BANDS];
+    uint8_t onsetHistoryIndex;
+    uint8_t onsetFrames;
+    uint8_t onsetBands;
+    bool onsetAbove;
+    bool onset;
+    uint32_t onsetTime;
+    float32_t onsetStrength;
+
+    // Bass branch, see decimateBass() and analyseBass()
+    int16_t bassTaps[BASS_TAPS * 2];    // Written twice, so the filter reads straight through
+    uint8_t bassTapIndex;
+    uint8_t bassPhase;
+    int16_t bassHistory[BASS_FFT_SAMPLES];
+    uint16_t bassHistoryIndex;
+    uint16_t bassHopCount;
+    bool bassPending;
+    uint8_t bassCopies;
+    uint32_t bassSequence;
+    arm_rfft_instance_q15 bassRfft;
+    q15_t bassSamples[BASS_FFT_SAMPLES];
+    q15_t bassSpectrum[BASS_FFT_SAMPLES * 2];
+    q15_t bassMagnitude[BASS_FFT_SAMPLES / 2];
+    NoiseFloor<q15_t, BASS_FFT_SAMPLES / 2> bassFloor;
+
+    gain_t updateGain(level_t loudest);
+    void detectOnset(uint32_t now);
+    void decimateBass(const volatile uint16_t *rawSamples, uint16_t count);
+    void analyseBass(Frame &frame, const Frame &previous);
 };
 
+// The analysis this build runs
+typedef AudioVisualizer<FFT_SAMPLES, SAMPLE_RATE> Visualizer;
+
+extern template class AudioVisualizer<FFT_SAMPLES, SAMPLE_RATE>;
+
 #endif
@@ -0,0 +1,140 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "DotStarOutput.h"
+#include "Profile.h"
+
+#define FRAME_START_BYTES   4
+
+DotStarOutput::DotStarOutput(uint16_t pixels, uint8_t dataPin, uint8_t clockPin, uint8_t order)
+    : Adafruit_DotStar(pixels, dataPin, clockPin, order)
+{
+    transport = NULL;
+    outputDataPin = dataPin;
+    outputClockPin = clockPin;
+
+    // One clock edge per pixel is needed past the last one to latch it
+    frameLength = DOTSTAR_FRAME_BYTES(pixels);
+    frame = (uint8_t *)malloc(frameLength);
+    sentPixels = (uint8_t *)malloc(pixels * 3);
+    sentBrightness = 0;
+    sent = false;
+    transfers = 0;
+    skipped = 0;
+    waits = 0;
+}
+
+DotStarOutput::~DotStarOutput() {
+    wait();
+    free(frame);
+    free(sentPixels);
+}
+
+/**
+ * Set up the transport. Hides Adafruit_DotStar::begin(), the pins belong to
+ * the transport now.
+ */
+void DotStarOutput::begin() {
+    if (transport == NULL && frame != NULL) {
+        memset(frame, 0, FRAME_START_BYTES);
+        memset(frame + frameLength - (numPixels() + 15) / 16, 0xFF, (numPixels() + 15) / 16);
+        transport = halPixelTransport(outputDataPin, outputClockPin);
+    }
+}
+
+// Brightness is applied here, like the library does while clocking out
+void DotStarOutput::encodeFrame() {
+    const uint8_t *pixels = getPixels();
+    uint8_t *out = frame + FRAME_START_BYTES;
+    uint16_t scale = (uint16_t)getBrightness() + 1;
+
+    for (uint16_t i = 0; i < numPixels(); i++) {
+        *out++ = 0xFF;
+        *out++ = (*pixels++ * scale) >> 8;
+        *out++ = (*pixels++ * scale) >> 8;
+        *out++ = (*pixels++ * scale) >> 8;
+    }
+}
+
+void DotStarOutput::show() {
+    if (transport == NULL) {
+        return;
+    }
+
+    uint32_t showStart = profileStart();
+    uint16_t bytes = numPixels() * 3;
+    if (sent && getBrightness() == sentBrightness && memcmp(getPixels(), sentPixels, bytes) == 0) {
+        skipped++;
+        profileEnd(PROFILE_SHOW, showStart);
+        return;
+    }
+
+    // The frame buffer is still being read out
+    if (transport->busy()) {
+        waits++;
+        transport->wait();
+    }
+
+    encodeFrame();
+    transport->submit(frame, frameLength);
+
+    if (sentPixels != NULL) {
+        memcpy(sentPixels, getPixels(), bytes);
+        sentBrightness = getBrightness();
+        sent = true;
+    }
+    transfers++;
+    profileEnd(PROFILE_SHOW, showStart);
+}
+
+/**
+ * Mix a saved frame at savedBrightness into the one just rendered at
+ * targetBrightness, `position` of 256 of the way to the new one. Each side is
+ * weighed by its own brightness and the mix goes out at the brighter of the
+ * two, so frames of different brightness blend by light rather than by
+ * value. Returns that brightness.
+ */
+uint8_t DotStarOutput::blendFrame(const uint8_t *savedPixels, uint8_t savedBrightness, uint8_t targetBrightness,
+                                  uint16_t position) {
+    uint8_t mixBrightness = max(savedBrightness, targetBrightness);
+    setBrightness(mixBrightness);
+    if (mixBrightness == 0) {
+        return 0;
+    }
+
+    uint16_t incoming = (uint32_t)targetBrightness * position / mixBrightness;
+    uint16_t outgoing = (uint32_t)savedBrightness * (256 - position) / mixBrightness;
+
+    uint8_t *pixels = getPixels();
+    uint16_t bytes = numPixels() * 3;
+    for (uint16_t i = 0; i < bytes; i++) {
+        pixels[i] = (pixels[i] * incoming + savedPixels[i] * outgoing) >> 8;
+    }
+    return mixBrightness;
+}
+
+bool DotStarOutput::busy() {
+    return transport != NULL && transport->busy();
+}
+
+/**
+ * Return once the last frame has been sent
+ */
+void DotStarOutput::wait() {
+    if (transport != NULL) {
+        transport->wait();
+    }
+}
+
+uint32_t DotStarOutput::getTransfers() {
+    return transfers;
+}
+
+uint32_t DotStarOutput::getSkipped() {
+    return skipped;
+}
+
+// show() calls that had to wait for the previous transfer
+uint32_t DotStarOutput::getWaits() {
+    return waits;
+}
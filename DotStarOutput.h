@@ -0,0 +1,65 @@
+#ifndef _DOTSTAR_OUTPUT_H_
+#define _DOTSTAR_OUTPUT_H_
+
+/******************************************************************************
+
+Adafruit_DotStar that only sends what changed, without waiting for it
+
+show() compares the pixels and brightness with what went out on the last
+transfer and skips the transfer when they are identical, so renderers can
+redraw every frame without paying for a transfer each time.
+
+Anything else is encoded into a DotStar frame (start frame, 0xFF plus three
+brightness scaled bytes per pixel, end frame) and handed to the PixelTransport
+for the pins (see Hal.h). With SPI over DMA show() returns as soon as the
+transfer has started, and the next show() only waits if that transfer is
+somehow still running. wait() is the fence for code that needs the frame out.
+
+blendFrame() mixes a saved frame into the one being drawn, for the displays'
+fades from one effect or mode to the next.
+
+******************************************************************************/
+
+#include <Adafruit_DotStar.h>
+
+#include "Hal.h"
+
+// Bytes on the wire for `pixels`: start frame, 4 per pixel, and an end frame
+// of a clock edge per pixel
+#define DOTSTAR_FRAME_BYTES(pixels) (4 + (pixels) * 4 + ((pixels) + 15) / 16)
+
+class DotStarOutput : public Adafruit_DotStar {
+public:
+    DotStarOutput(uint16_t pixels, uint8_t dataPin, uint8_t clockPin, uint8_t order);
+    ~DotStarOutput();
+
+    void begin();
+    void show();
+    bool busy();
+    void wait();
+
+    uint32_t getTransfers();
+    uint32_t getSkipped();
+    uint32_t getWaits();
+
+protected:
+    uint8_t blendFrame(const uint8_t *savedPixels, uint8_t savedBrightness, uint8_t targetBrightness,
+                       uint16_t position);
+
+private:
+    PixelTransport *transport;
+    uint8_t outputDataPin;
+    uint8_t outputClockPin;
+    uint8_t *frame;
+    uint16_t frameLength;
+    uint8_t *sentPixels;
+    uint8_t sentBrightness;
+    bool sent;
+    uint32_t transfers;
+    uint32_t skipped;
+    uint32_t waits;
+
+    void encodeFrame();
+};
+
+#endif
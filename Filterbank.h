@@ -0,0 +1,154 @@
+#ifndef _FILTERBANK_H_
+#define _FILTERBANK_H_
+
+/******************************************************************************
+
+Triangular filterbank from FFT bins to display columns, built by the compiler
+
+Column centres are spaced evenly on a frequency scale, but never closer than
+one bin, so the low end is one column per bin and the rest of the spectrum is
+shared out by the scale. Every bin is split between the two columns either
+side of it, which packs the whole weight matrix into one entry per bin:
+
+    column[bin]      the lower of the two columns
+    weight[bin]      share of the bin that goes to that column, in Q15 up to
+                     32768 for all of it; the rest goes to column + 1
+
+Each column is then scaled by its gain[], one over its total weight in Q16,
+so a column reads as the average level of its bins whatever its width.
+Levels go in and come out as Q15. Like Window.h this sticks to
+C++11 constexpr, so the table lands in flash as a plain constant.
+
+******************************************************************************/
+
+#include <arm_math.h>
+
+#define FREQUENCY_SCALE_LINEAR  0
+#define FREQUENCY_SCALE_LOG     1
+#define FREQUENCY_SCALE_MEL     2
+#define FREQUENCY_SCALE_BARK    3
+
+#define FILTERBANK_LN2          0.69314718055994530942
+#define FILTERBANK_LN10         2.30258509299404568402
+
+// ln(x) for x > 0: halve or double into [1, 2], then the atanh series
+constexpr double filterbankLnSeries(double y2, double term, int n, double sum) {
+    return n > 40 ? sum : filterbankLnSeries(y2, term * y2, n + 2, sum + term / n);
+}
+
+constexpr double filterbankLn(double x) {
+    return x > 2 ? filterbankLn(x / 2) + FILTERBANK_LN2 :
+           x < 1 ? filterbankLn(x * 2) - FILTERBANK_LN2 :
+           2 * filterbankLnSeries(((x - 1) / (x + 1)) * ((x - 1) / (x + 1)), (x - 1) / (x + 1), 1, 0);
+}
+
+/**
+ * Position of `frequency` on `scale`. LOG is log(1 + f / bin width), which is
+ * logarithmic above the first bin and still defined at DC. BARK is
+ * Traunmüller's approximation.
+ */
+constexpr double filterbankScale(int scale, double frequency, double binWidth) {
+    return scale == FREQUENCY_SCALE_LOG ? filterbankLn(1 + frequency / binWidth) :
+           scale == FREQUENCY_SCALE_MEL ? 2595 * filterbankLn(1 + frequency / 700) / FILTERBANK_LN10 :
+           scale == FREQUENCY_SCALE_BARK ? 26.81 * frequency / (1960 + frequency) - 0.53 :
+           frequency;
+}
+
+/**
+ * Filterbank over the first BINS bins of a FFT_SIZE point FFT at RATE Hz
+ */
+template<int COLUMNS, int BINS, int FFT_SIZE, int RATE, int SCALE>
+struct Filterbank {
+    int8_t column[BINS];
+    uint16_t weight[BINS];
+    uint32_t gain[COLUMNS];
+
+    static constexpr double binWidth() {
+        return (double)RATE / FFT_SIZE;
+    }
+
+    // Fractional column of a bin on the scale alone
+    static constexpr double scalePosition(int bin) {
+        return (filterbankScale(SCALE, bin * binWidth(), binWidth()) - filterbankScale(SCALE, 0, binWidth())) /
+               (filterbankScale(SCALE, (BINS - 1) * binWidth(), binWidth()) - filterbankScale(SCALE, 0, binWidth())) *
+               (COLUMNS - 1);
+    }
+
+    // ...but no more than one column per bin
+    static constexpr double position(int bin) {
+        return scalePosition(bin) < bin ? scalePosition(bin) : bin;
+    }
+
+    static constexpr int lower(int bin) {
+        return (int)position(bin);
+    }
+
+    static constexpr double lowerWeight(int bin) {
+        return 1.0 - (position(bin) - lower(bin));
+    }
+
+    static constexpr double share(int bin, int column) {
+        return lower(bin) == column ? lowerWeight(bin) :
+               lower(bin) + 1 == column ? 1.0 - lowerWeight(bin) :
+               0.0;
+    }
+
+    static constexpr double total(int column, int bin) {
+        return bin >= BINS ? 0.0 : share(bin, column) + total(column, bin + 1);
+    }
+
+    static constexpr double columnGain(int column) {
+        return total(column, 0) > 0 ? 1.0 / total(column, 0) : 0.0;
+    }
+
+    static constexpr uint16_t lowerWeightQ15(int bin) {
+        return (uint16_t)(lowerWeight(bin) * 32768 + 0.5);
+    }
+
+    static constexpr uint32_t columnGainQ16(int column) {
+        return (uint32_t)(columnGain(column) * 65536 + 0.5);
+    }
+};
+
+template<int... I> struct FilterbankIndices {};
+template<int N, int... I> struct MakeFilterbankIndices : MakeFilterbankIndices<N - 1, N - 1, I...> {};
+template<int... I> struct MakeFilterbankIndices<0, I...> { typedef FilterbankIndices<I...> type; };
+
+template<typename F, int... B, int... C>
+constexpr F makeFilterbankTable(FilterbankIndices<B...>, FilterbankIndices<C...>) {
+    return {{ (int8_t)F::lower(B)... }, { F::lowerWeightQ15(B)... }, { F::columnGainQ16(C)... }};
+}
+
+template<int COLUMNS, int BINS, int FFT_SIZE, int RATE, int SCALE>
+constexpr Filterbank<COLUMNS, BINS, FFT_SIZE, RATE, SCALE> makeFilterbank() {
+    return makeFilterbankTable<Filterbank<COLUMNS, BINS, FFT_SIZE, RATE, SCALE> >(
+        typename MakeFilterbankIndices<BINS>::type(), typename MakeFilterbankIndices<COLUMNS>::type());
+}
+
+/**
+ * Levels of every column in one pass over the bins. `scratch` needs
+ * COLUMNS + 1 entries, the last one soaks up the share above the top column.
+ * A column sums to at most 32767 over its total weight, so with the gain it
+ * stays inside 32 bits unsigned.
+ */
+template<int COLUMNS, int BINS, int FFT_SIZE, int RATE, int SCALE>
+inline void applyFilterbank(const Filterbank<COLUMNS, BINS, FFT_SIZE, RATE, SCALE> &filterbank,
+                            const q15_t *bins, uint32_t *scratch, q15_t *columns) {
+    for (int c = 0; c <= COLUMNS; c++) {
+        scratch[c] = 0;
+    }
+
+    for (int b = 0; b < BINS; b++) {
+        uint32_t level = bins[b] > 0 ? bins[b] : 0;
+        uint32_t part = (level * filterbank.weight[b] + (1 << 14)) >> 15;
+        scratch[filterbank.column[b]] += part;
+        scratch[filterbank.column[b] + 1] += level - part;
+    }
+
+    for (int c = 0; c < COLUMNS; c++) {
+        uint32_t level = (scratch[c] * filterbank.gain[c] + (1 << 15)) >> 16;
+        columns[c] = (q15_t)(level > 32767 ? 32767 : level);
+    }
+}
+
+#endif
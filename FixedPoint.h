@@ -0,0 +1,56 @@
+#ifndef _FIXED_POINT_H_
+#define _FIXED_POINT_H_
+
+/******************************************************************************
+
+Integer helpers for the Q15 analysis
+
+Levels everywhere past the FFT are Q15, 32767 being 1. Magnitudes come from
+complexMagnitudes() rather than arm_cmplx_mag_q15: CMSIS shifts the sum of
+squares down to Q15 before its square root, so every magnitude under 181
+(2.14 format) comes out as 0 and the ones above it in coarse steps, which
+loses most of a quiet room. Here the root is taken of the whole 32-bit sum.
+
+******************************************************************************/
+
+#include <arm_math.h>
+
+// floor(sqrt(value)), a bit at a time
+inline uint32_t squareRoot(uint32_t value) {
+    uint32_t result = 0;
+    uint32_t bit = 1UL << 30;
+
+    while (bit > value) {
+        bit >>= 2;
+    }
+
+    while (bit != 0) {
+        if (value >= result + bit) {
+            value -= result + bit;
+            result = (result >> 1) + bit;
+        } else {
+            result >>= 1;
+        }
+        bit >>= 2;
+    }
+
+    return result;
+}
+
+inline q15_t saturateQ15(int32_t value) {
+    return (q15_t)(value > 32767 ? 32767 : (value < -32768 ? -32768 : value));
+}
+
+/**
+ * Magnitudes of `count` interleaved complex values, in the same 2.14 format
+ * as arm_cmplx_mag_q15, rounded
+ */
+inline void complexMagnitudes(const q15_t *spectrum, q15_t *magnitudes, uint16_t count) {
+    for (uint16_t i = 0; i < count; i++) {
+        int32_t re = spectrum[2 * i];
+        int32_t im = spectrum[2 * i + 1];
+        magnitudes[i] = (q15_t)((squareRoot((uint32_t)(re * re) + (uint32_t)(im * im)) + 1) >> 1);
+    }
+}
+
+#endif
@@ -0,0 +1,102 @@
+#ifndef _HAL_H_
+#define _HAL_H_
+
+/******************************************************************************
+
+Hardware abstraction layer
+
+Everything the firmware needs from the board goes through here, so the same
+AudioVisualizer, Matrix and Strip code runs on the Feather M0 (HalSamd.cpp)
+and in the native simulation (host/HalHost.cpp).
+
+    - Sample source: gap-free blocks of SAMPLE_BLOCK raw 12-bit ADC counts
+    - Clock:         millisecond / microsecond timestamps, and profiling
+                     clocks in microseconds and CPU cycles for measuring how
+                     long code takes
+    - RNG:           Arduino style random()
+    - Idle:          sleep until the next interrupt
+    - Pixel output:  a transport per LED chain that clocks out prepared frames,
+                     in the background where the hardware allows
+
+Matrix and Strip still keep their pixels in Adafruit_DotStar (the host build
+supplies a stand-in in host/include), but frames go out through DotStarOutput
+and a PixelTransport rather than the library's show().
+
+******************************************************************************/
+
+#include <Arduino.h>
+
+#include "constants.h"
+
+// Sample source
+//
+// Capture runs continuously into two alternating buffers. halSampleAvailable()
+// returns the newest completed block (or NULL if there is none since the last
+// release); it stays valid for one block time while the other buffer fills.
+// Blocks that completed unread are dropped and counted as overruns.
+void halSampleBegin();
+const volatile uint16_t* halSampleAvailable();
+void halSampleRelease();
+uint32_t halSampleOverruns();
+
+// Clock
+//
+// halProfileMicros() and halProfileCycles() are for execution times only. On
+// the device they are halMicros() and the CPU cycles SysTick counts at
+// HAL_CPU_CLOCK; the host's virtual clock stands still while firmware code
+// runs, so there they read the real clock instead, cycles scaled to
+// HAL_CPU_CLOCK. Both wrap round, so only differences mean anything.
+#define HAL_CPU_CLOCK   48000000
+
+uint32_t halMillis();
+uint32_t halMicros();
+uint32_t halProfileMicros();
+uint32_t halProfileCycles();
+
+// Idle
+//
+// halIdle() stops the CPU until the next interrupt (capture block complete,
+// the 1 ms system tick, USB, pixel DMA) unless a captured block is already
+// waiting, and returns whether it slept; halSamplePending() is that check on
+// its own. The host returns straight away, the simulator's loop tick stands
+// in for the sleep.
+bool halSamplePending();
+bool halIdle();
+
+// RNG
+int32_t halRandom(int32_t maximum);
+int32_t halRandom(int32_t minimum, int32_t maximum);
+
+// Pixel output
+//
+// submit() starts sending a frame and may return before it is out; the frame
+// has to stay untouched until busy() is false. wait() is the completion fence:
+// it returns once the last submitted frame has been read. On the SAMD21 a
+// data/clock pair on SERCOM pads gets SPI fed by the DMAC at PIXEL_SPI_CLOCK,
+// any other pair is bit-banged and submit() only returns when it is done. The
+// host keeps the frame in memory and hands it to the pixel sink; it models the
+// same split, busy for as long as the SPI transfer would take on the pairs
+// the SAMD21 maps and holding up the caller at PIXEL_BITBANG_CLOCK on the rest.
+//
+// The goggles as wired use neither pair: the matrix is on D13/D12 and the
+// strip on D6/D5, so both are bit-banged and show() blocks for the whole frame
+// (goggles.ino sizes the sample block around it). Background output needs the
+// matrix data wire moved from D13 to D11 (SERCOM1, clock staying on D12) and
+// the strip on MOSI/SCK (SERCOM4), with MATRIX_DATA_PIN and the LED_STRIP pins
+// changed to match; host/check/pixels.cpp checks which one each display gets.
+#define PIXEL_SPI_CLOCK     8000000
+// Estimated from BitBangTransport's loop, about 16 cycles a bit at 48MHz
+#define PIXEL_BITBANG_CLOCK 3000000
+
+class PixelTransport {
+public:
+    virtual ~PixelTransport() {}
+
+    virtual void submit(const uint8_t *frame, uint16_t length) = 0;
+    virtual bool busy() = 0;
+    virtual void wait() = 0;
+};
+
+PixelTransport* halPixelTransport(uint8_t dataPin, uint8_t clockPin);
+
+#endif
@@ -0,0 +1,440 @@
+/**
+ *  SAMD21 (Feather M0) implementation of Hal.h
+ *
+ *  The ADC runs in free running mode and every result is moved by DMAC channel
+ *  ADC_DMA_CHANNEL into one of two buffers. The two descriptors are linked in a
+ *  ring, so the DMAC flips between the buffers by itself and the only interrupt
+ *  left is one per completed block, which just bumps a counter.
+ *
+ *  Pixel outputs on a SERCOM pad pair run that SERCOM as an SPI master and
+ *  feed it from their own DMAC channel, one descriptor per frame. The other
+ *  DMAC channels share the controller, descriptors and interrupt with capture.
+ */
+
+#ifdef ARDUINO_ARCH_SAMD
+
+#include "Hal.h"
+#include "wiring_private.h"
+
+#if SAMPLE_RATE != 14400
+#error "The ADC prescaler below is set up for SAMPLE_RATE 14400"
+#endif
+
+#define WAIT_ADC_SYNC   while (ADC->STATUS.bit.SYNCBUSY) {}
+#define WAIT_ADC_RESET  while (ADC->CTRLA.bit.SWRST) {}
+
+#define ADC_CHANNEL             0x00
+#define ADC_DMA_CHANNEL         0
+#define PIXEL_DMA_CHANNEL       1
+#define DMA_CHANNELS            3
+
+volatile uint16_t rawSamples[2][SAMPLE_BLOCK];
+volatile uint32_t completedBlocks = 0;
+uint32_t availableBlock = 0;
+uint32_t consumedBlocks = 0;
+uint32_t overruns = 0;
+
+// First descriptor of each channel lives in the base section, the write-back
+// section holds the one in flight
+__attribute__((aligned(16))) DmacDescriptor dmaDescriptors[DMA_CHANNELS];
+__attribute__((aligned(16))) DmacDescriptor dmaLinkedDescriptor;
+__attribute__((aligned(16))) volatile DmacDescriptor dmaWriteback[DMA_CHANNELS];
+bool dmaStarted = false;
+uint8_t nextPixelChannel = PIXEL_DMA_CHANNEL;
+volatile bool pixelChannelBusy[DMA_CHANNELS];
+
+static void initADC() {
+    ADC->CTRLA.bit.ENABLE = 0;          // Disable ADC
+    WAIT_ADC_SYNC;
+
+    // Set external voltage reference to AREF pin
+    ADC->REFCTRL.bit.REFSEL = ADC_REFCTRL_REFSEL_AREFA_Val;
+    WAIT_ADC_SYNC;
+
+    // Set the clock prescaler (48MHz / 512 / 6.5 cycles per conversion = ~14.4kHz, SAMPLE_RATE)
+    // Set 12bit resolution
+    // Set free running mode (a new conversion will begin as a previous one completes)
+    ADC->CTRLB.reg = ADC_CTRLB_PRESCALER_DIV512 | ADC_CTRLB_RESSEL_12BIT | ADC_CTRLB_FREERUN;
+    WAIT_ADC_SYNC;
+
+    // Set input to read from ADC_CHANNEL and Ground
+    ADC->INPUTCTRL.reg = ADC_CHANNEL | ADC_INPUTCTRL_MUXNEG_GND | ADC_INPUTCTRL_GAIN_1X;
+    WAIT_ADC_SYNC;
+
+    ADC->CTRLA.bit.ENABLE = 1;
+    WAIT_ADC_SYNC;
+}
+
+static void resetADC() {
+    WAIT_ADC_SYNC;
+
+    ADC->CTRLA.bit.ENABLE = 0;          // Disable ADC
+    WAIT_ADC_SYNC;
+
+    ADC->CTRLA.bit.SWRST = 1;           // Reset ADC
+    WAIT_ADC_SYNC;
+    WAIT_ADC_RESET;
+}
+
+static void initDescriptor(DmacDescriptor *descriptor, volatile uint16_t *buffer, DmacDescriptor *next) {
+    descriptor->BTCTRL.reg = DMAC_BTCTRL_VALID |
+                             DMAC_BTCTRL_BLOCKACT_INT |
+                             DMAC_BTCTRL_BEATSIZE_HWORD |
+                             DMAC_BTCTRL_DSTINC;
+    descriptor->BTCNT.reg = SAMPLE_BLOCK;
+    descriptor->SRCADDR.reg = (uint32_t)&ADC->RESULT.reg;
+    // With address increment enabled the DMAC wants the end of the buffer
+    descriptor->DSTADDR.reg = (uint32_t)(buffer + SAMPLE_BLOCK);
+    descriptor->DESCADDR.reg = (uint32_t)next;
+}
+
+// Controller setup, shared by every channel
+static void startDMA() {
+    if (dmaStarted) {
+        return;
+    }
+
+    PM->AHBMASK.reg |= PM_AHBMASK_DMAC;
+    PM->APBBMASK.reg |= PM_APBBMASK_DMAC;
+
+    DMAC->CTRL.bit.DMAENABLE = 0;
+    DMAC->CTRL.bit.SWRST = 1;
+    while (DMAC->CTRL.bit.SWRST) {}
+
+    DMAC->BASEADDR.reg = (uint32_t)dmaDescriptors;
+    DMAC->WRBADDR.reg = (uint32_t)dmaWriteback;
+    DMAC->CTRL.reg = DMAC_CTRL_DMAENABLE | DMAC_CTRL_LVLEN(0xF);
+
+    NVIC_ClearPendingIRQ(DMAC_IRQn);
+    NVIC_EnableIRQ(DMAC_IRQn);
+
+    dmaStarted = true;
+}
+
+static void initDMA() {
+    startDMA();
+
+    // Ping-pong: buffer 0 -> buffer 1 -> buffer 0 ...
+    initDescriptor(&dmaDescriptors[ADC_DMA_CHANNEL], rawSamples[0], &dmaLinkedDescriptor);
+    initDescriptor(&dmaLinkedDescriptor, rawSamples[1], &dmaDescriptors[ADC_DMA_CHANNEL]);
+
+    DMAC->CHID.reg = DMAC_CHID_ID(ADC_DMA_CHANNEL);
+    DMAC->CHCTRLA.reg &= ~DMAC_CHCTRLA_ENABLE;
+    DMAC->CHCTRLA.reg = DMAC_CHCTRLA_SWRST;
+    while (DMAC->CHCTRLA.reg & DMAC_CHCTRLA_SWRST) {}
+
+    // One beat (one 16 bit result) per ADC result ready
+    DMAC->CHCTRLB.reg = DMAC_CHCTRLB_LVL(0) |
+                        DMAC_CHCTRLB_TRIGSRC(ADC_DMAC_ID_RESRDY) |
+                        DMAC_CHCTRLB_TRIGACT_BEAT;
+    DMAC->CHINTENSET.reg = DMAC_CHINTENSET_TCMPL;
+
+    DMAC->CHCTRLA.reg |= DMAC_CHCTRLA_ENABLE;
+}
+
+/**
+ * Initialize the ADC clock and start continuous capture
+ */
+void halSampleBegin() {
+    completedBlocks = 0;
+    availableBlock = 0;
+    consumedBlocks = 0;
+    overruns = 0;
+
+    // Make sure to enable the ADC clock in power management
+    PM->APBCMASK.reg |= PM_APBCMASK_ADC;
+
+    // Enable the generic clock for ADC
+    GCLK->CLKCTRL.reg = GCLK_CLKCTRL_CLKEN | GCLK_CLKCTRL_GEN_GCLK0 | GCLK_CLKCTRL_ID(GCM_ADC);
+    while (GCLK->STATUS.bit.SYNCBUSY);
+
+    resetADC();
+    initDMA();
+    initADC();
+}
+
+const volatile uint16_t* halSampleAvailable() {
+    uint32_t completed = completedBlocks;
+    if (completed == consumedBlocks) {
+        return NULL;
+    }
+
+    // Count every block that went by unread once: those since the last one
+    // handed out, and that one too if it was never released
+    if (completed != availableBlock) {
+        overruns += completed - availableBlock - (availableBlock > consumedBlocks ? 0 : 1);
+        availableBlock = completed;
+    }
+
+    // Block n (counting from 1) was written to buffer (n - 1) % 2
+    return rawSamples[(completed - 1) & 1];
+}
+
+/**
+ * Mark the block returned by halSampleAvailable() as consumed
+ */
+void halSampleRelease() {
+    consumedBlocks = availableBlock;
+}
+
+uint32_t halSampleOverruns() {
+    return overruns;
+}
+
+bool halSamplePending() {
+    return completedBlocks != consumedBlocks;
+}
+
+/**
+ * Sleep in IDLE 0: only the CPU clock stops, so the ADC, DMAC, SERCOMs and USB
+ * keep running and any of their interrupts wakes it again. Standby would stop
+ * the capture. Interrupts are masked around the check so a block that lands
+ * just before the WFI still wakes it straight away.
+ */
+bool halIdle() {
+    SCB->SCR &= ~SCB_SCR_SLEEPDEEP_Msk;
+    PM->SLEEP.reg = PM_SLEEP_IDLE_CPU;
+
+    __disable_irq();
+    bool sleep = !halSamplePending();
+    if (sleep) {
+        __DSB();
+        __WFI();
+    }
+    __enable_irq();
+
+    return sleep;
+}
+
+uint32_t halMillis() {
+    return millis();
+}
+
+uint32_t halMicros() {
+    return micros();
+}
+
+uint32_t halProfileMicros() {
+    return micros();
+}
+
+static_assert(F_CPU == HAL_CPU_CLOCK, "Profiling cycles assume the CPU runs at HAL_CPU_CLOCK");
+
+/**
+ * SysTick counts every millisecond's cycles down from LOAD and the core counts
+ * the reloads, so together they are a cycle counter. Like the core's micros(),
+ * read both until two reads agree, so a reload in between is not lost.
+ */
+uint32_t halProfileCycles() {
+    uint32_t ticks, milliseconds, pending;
+    uint32_t ticks2 = SysTick->VAL;
+    uint32_t pending2 = (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) != 0;
+    uint32_t milliseconds2 = millis();
+
+    do {
+        ticks = ticks2;
+        pending = pending2;
+        milliseconds = milliseconds2;
+        ticks2 = SysTick->VAL;
+        pending2 = (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) != 0;
+        milliseconds2 = millis();
+    } while (pending != pending2 || milliseconds != milliseconds2 || ticks < ticks2);
+
+    return (milliseconds + pending) * (SysTick->LOAD + 1) + (SysTick->LOAD - ticks);
+}
+
+int32_t halRandom(int32_t maximum) {
+    return random(maximum);
+}
+
+int32_t halRandom(int32_t minimum, int32_t maximum) {
+    return random(minimum, maximum);
+}
+
+/**
+ * Pixel output through GPIO, for pins that are not on a usable SERCOM pad
+ * pair. Same timing as the Adafruit_DotStar software SPI: as fast as the port
+ * registers can be written.
+ */
+class BitBangTransport : public PixelTransport {
+public:
+    BitBangTransport(uint8_t dataPin, uint8_t clockPin) {
+        pinMode(dataPin, OUTPUT);
+        pinMode(clockPin, OUTPUT);
+
+        dataPort = &PORT->Group[g_APinDescription[dataPin].ulPort];
+        dataMask = 1ul << g_APinDescription[dataPin].ulPin;
+        clockPort = &PORT->Group[g_APinDescription[clockPin].ulPort];
+        clockMask = 1ul << g_APinDescription[clockPin].ulPin;
+
+        dataPort->OUTCLR.reg = dataMask;
+        clockPort->OUTCLR.reg = clockMask;
+    }
+
+    void submit(const uint8_t *frame, uint16_t length) {
+        for (uint16_t i = 0; i < length; i++) {
+            uint8_t value = frame[i];
+            for (uint8_t bit = 0; bit < 8; bit++, value <<= 1) {
+                if (value & 0x80) {
+                    dataPort->OUTSET.reg = dataMask;
+                } else {
+                    dataPort->OUTCLR.reg = dataMask;
+                }
+                clockPort->OUTSET.reg = clockMask;
+                clockPort->OUTCLR.reg = clockMask;
+            }
+        }
+    }
+
+    bool busy() {
+        return false;
+    }
+
+    void wait() {
+    }
+
+private:
+    PortGroup *dataPort;
+    PortGroup *clockPort;
+    uint32_t dataMask;
+    uint32_t clockMask;
+};
+
+// Feather M0 pin pairs that land on the data out and clock pads of one SERCOM
+struct PixelSpiPins {
+    uint8_t dataPin;
+    uint8_t clockPin;
+    Sercom *sercom;
+    uint8_t dataOutPinout;
+    EPioType mux;
+    uint8_t clockId;
+    uint32_t busMask;
+    uint8_t transmitTrigger;
+};
+
+static const PixelSpiPins pixelSpiPins[] = {
+    // D11 = PA16 (PAD0), D12 = PA19 (PAD3)
+    { 11, 12, SERCOM1, 0x3, PIO_SERCOM, SERCOM1_GCLK_ID_CORE, PM_APBCMASK_SERCOM1, SERCOM1_DMAC_ID_TX },
+    // MOSI = PB10 (PAD2), SCK = PB11 (PAD3)
+    { PIN_SPI_MOSI, PIN_SPI_SCK, SERCOM4, 0x1, PIO_SERCOM_ALT, SERCOM4_GCLK_ID_CORE, PM_APBCMASK_SERCOM4,
+      SERCOM4_DMAC_ID_TX }
+};
+
+/**
+ * Pixel output through a SERCOM in SPI master mode (mode 0, MSB first),
+ * written one byte per transmit-ready trigger by a DMAC channel
+ */
+class SercomDmaTransport : public PixelTransport {
+public:
+    SercomDmaTransport(const PixelSpiPins &pins, uint8_t pChannel) {
+        sercom = pins.sercom;
+        channel = pChannel;
+        pixelChannelBusy[channel] = false;
+
+        pinPeripheral(pins.dataPin, pins.mux);
+        pinPeripheral(pins.clockPin, pins.mux);
+
+        PM->APBCMASK.reg |= pins.busMask;
+        GCLK->CLKCTRL.reg = GCLK_CLKCTRL_CLKEN | GCLK_CLKCTRL_GEN_GCLK0 | GCLK_CLKCTRL_ID(pins.clockId);
+        while (GCLK->STATUS.bit.SYNCBUSY);
+
+        sercom->SPI.CTRLA.bit.ENABLE = 0;
+        while (sercom->SPI.SYNCBUSY.bit.ENABLE) {}
+        sercom->SPI.CTRLA.bit.SWRST = 1;
+        while (sercom->SPI.CTRLA.bit.SWRST || sercom->SPI.SYNCBUSY.bit.SWRST) {}
+
+        // Transmit only, 8 bit characters, clock idles low and data is sampled on the rising edge
+        sercom->SPI.CTRLA.reg = SERCOM_SPI_CTRLA_MODE_SPI_MASTER | SERCOM_SPI_CTRLA_DOPO(pins.dataOutPinout);
+        sercom->SPI.CTRLB.reg = SERCOM_SPI_CTRLB_CHSIZE(0);
+        while (sercom->SPI.SYNCBUSY.bit.CTRLB) {}
+        sercom->SPI.BAUD.reg = F_CPU / (2 * PIXEL_SPI_CLOCK) - 1;
+
+        sercom->SPI.CTRLA.bit.ENABLE = 1;
+        while (sercom->SPI.SYNCBUSY.bit.ENABLE) {}
+
+        startDMA();
+
+        DMAC->CHID.reg = DMAC_CHID_ID(channel);
+        DMAC->CHCTRLA.reg &= ~DMAC_CHCTRLA_ENABLE;
+        DMAC->CHCTRLA.reg = DMAC_CHCTRLA_SWRST;
+        while (DMAC->CHCTRLA.reg & DMAC_CHCTRLA_SWRST) {}
+
+        DMAC->CHCTRLB.reg = DMAC_CHCTRLB_LVL(0) |
+                            DMAC_CHCTRLB_TRIGSRC(pins.transmitTrigger) |
+                            DMAC_CHCTRLB_TRIGACT_BEAT;
+        DMAC->CHINTENSET.reg = DMAC_CHINTENSET_TCMPL;
+    }
+
+    void submit(const uint8_t *frame, uint16_t length) {
+        wait();
+
+        DmacDescriptor *descriptor = &dmaDescriptors[channel];
+        descriptor->BTCTRL.reg = DMAC_BTCTRL_VALID |
+                                 DMAC_BTCTRL_BLOCKACT_NOACT |
+                                 DMAC_BTCTRL_BEATSIZE_BYTE |
+                                 DMAC_BTCTRL_SRCINC;
+        descriptor->BTCNT.reg = length;
+        // With address increment enabled the DMAC wants the end of the buffer
+        descriptor->SRCADDR.reg = (uint32_t)(frame + length);
+        descriptor->DSTADDR.reg = (uint32_t)&sercom->SPI.DATA.reg;
+        descriptor->DESCADDR.reg = 0;
+
+        pixelChannelBusy[channel] = true;
+
+        // DMAC_Handler puts CHID back the way it found it
+        DMAC->CHID.reg = DMAC_CHID_ID(channel);
+        DMAC->CHCTRLA.reg |= DMAC_CHCTRLA_ENABLE;
+    }
+
+    bool busy() {
+        return pixelChannelBusy[channel];
+    }
+
+    void wait() {
+        while (pixelChannelBusy[channel]) {}
+    }
+
+private:
+    Sercom *sercom;
+    uint8_t channel;
+};
+
+/**
+ * Transport for a DotStar chain, SPI over DMA if the pins allow it and there
+ * is a DMAC channel left, bit-banged otherwise
+ */
+PixelTransport* halPixelTransport(uint8_t dataPin, uint8_t clockPin) {
+    for (uint8_t i = 0; i < sizeof(pixelSpiPins) / sizeof(pixelSpiPins[0]); i++) {
+        const PixelSpiPins &pins = pixelSpiPins[i];
+        if (pins.dataPin == dataPin && pins.clockPin == clockPin && nextPixelChannel < DMA_CHANNELS) {
+            return new SercomDmaTransport(pins, nextPixelChannel++);
+        }
+    }
+
+    return new BitBangTransport(dataPin, clockPin);
+}
+
+void DMAC_Handler(void) {
+    uint8_t previous = DMAC->CHID.reg;
+    uint16_t pending = DMAC->INTSTATUS.reg;
+
+    for (uint8_t channel = 0; channel < DMA_CHANNELS; channel++) {
+        if (!(pending & (1 << channel))) {
+            continue;
+        }
+
+        DMAC->CHID.reg = DMAC_CHID_ID(channel);
+        if (DMAC->CHINTFLAG.bit.TCMPL) {
+            DMAC->CHINTFLAG.reg = DMAC_CHINTFLAG_TCMPL;
+            if (channel == ADC_DMA_CHANNEL) {
+                completedBlocks++;
+            } else {
+                pixelChannelBusy[channel] = false;
+            }
+        }
+    }
+
+    DMAC->CHID.reg = previous;
+}
+
+#endif
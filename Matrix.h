@@ -3,47 +3,87 @@
 
 #include <arm_math.h>
 #include <Adafruit_GFX.h>
-#include <Adafruit_DotStar.h>
 
 #include "AudioVisualizer.h"
+#include "DotStarOutput.h"
+#include "MatrixEffect.h"
+#include "Sprite.h"
+#include "TextScroller.h"
 #include "constants.h"
 
 #define MATRIX_SIZE         8
 #define MATRIX_DATA_PIN     13
 #define MATRIX_CLOCK_PIN    12
 
-class Matrix : public Adafruit_GFX, public Adafruit_DotStar {
+// Per frame colour table, see Matrix::updatePalette()
+#define PALETTE_LOW         0
+#define PALETTE_MEDIUM      1
+#define PALETTE_HIGH        2
+#define PALETTE_HEART       3
+#define PALETTE_COLORS      4
+
+// Effects run for their duration plus up to this many ms, then fade over
+// MATRIX_CROSSFADE ms into the next one
+#define MATRIX_EFFECT_JITTER    2000
+#define MATRIX_CROSSFADE        400
+
+class Matrix : public Adafruit_GFX, public DotStarOutput {
 
 public:
     Matrix();
 
-    void drawPicture(const uint8_t picture[]);
-    void drawPictures(const uint8_t *pictures[], uint8_t frameIndex);
+    void drawPicture(const Sprite &picture);
+    void drawPictures(const Sprite *pictures[], uint8_t frameIndex);
+    void drawSprite(int16_t x, int16_t y, const Sprite &sprite);
+    void drawSpriteMask(int16_t x, int16_t y, const Sprite &sprite, uint32_t color);
     void drawPixel(int16_t x, int16_t y, uint16_t color);
     void fillScreen(uint16_t color);
-    void initialize(AudioVisualizer pVisualizer);
-    void loop();
+    void setPixelRGB(int16_t x, int16_t y, uint32_t color);
+    void fillRGB(int16_t x, int16_t y, int16_t w, int16_t h, uint32_t color);
+    void setText(const char *message);
+    void setText(const __FlashStringHelper *message);
+    void setTextSpeed(uint16_t columnsPerFrame);
+    void setTextRGB(uint32_t color);
+    void initialize(const Visualizer &pVisualizer);
+    void loop(uint32_t tickTime);
+    uint8_t getStripMode() const;
+
+    // For effects, see MatrixEffect.h
+    uint32_t getTime();
+    uint32_t getColor(uint8_t index);
+    const Visualizer::Frame& getFrame();
+    void advancePalette(uint8_t step);
+    void drawText();
+    void restartText();
 
     static uint16_t Color(uint8_t red, uint8_t green, uint8_t blue);
+    static uint32_t expandColor(uint16_t color);
+    static uint16_t pixelIndex(int16_t x, int16_t y);
 
 private:
     uint8_t colorIndex;
     uint8_t colorPosition;
-    uint8_t state;
-    int32_t frameIndex;
-    long lastTime;
-    long stateDuration;
-    uint8_t eyeDirection;
-    long lastBlink;
-    long lastStateChange;
-    AudioVisualizer visualizer;
-
-    void animate(const uint8_t *frames[], uint8_t numberOfFrames, uint32_t frameDuration);
-    void renderEyes();
-    void drawBars();
-    void drawHearts();
-    void visualize();
-    void writeText();
+    uint32_t palette[PALETTE_COLORS];
+    uint32_t now;
+    TextScroller text;
+    uint32_t textColor;
+    const Visualizer *visualizer;
+
+    // Current effect, and the last frame of the one before while fading
+    uint8_t effect;
+    uint16_t totalWeight;
+    uint32_t nextChange;
+    uint8_t brightness;
+    bool fading;
+    uint32_t fadeStart;
+    uint8_t fadeBrightness;
+    uint8_t fadePixels[MATRIX_SIZE * 2 * MATRIX_SIZE * 3];
+
+    void decodeSprite(int16_t x, int16_t y, const Sprite &sprite, bool masked, uint32_t maskColor);
+    void updatePalette();
+    uint8_t pickEffect();
+    void startEffect(uint8_t index);
+    void crossfade(uint8_t targetBrightness);
 };
 
 #endif
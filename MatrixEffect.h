@@ -0,0 +1,35 @@
+#ifndef _MATRIX_EFFECT_H_
+#define _MATRIX_EFFECT_H_
+
+/******************************************************************************
+
+Matrix effects
+
+An effect is one row of matrixEffects[] (MatrixEffects.cpp): how to start it,
+how to draw a frame, how long it runs, how often it is picked and which strip
+mode (STRIP_* in Strip.h) goes with it. Effects draw into a cleared buffer;
+the Matrix sets their brightness, fades in from the previous effect and shows
+the frame. Adding one is a start and a render function and a row in that
+table, all in MatrixEffects.cpp.
+
+******************************************************************************/
+
+#include <stdint.h>
+
+class Matrix;
+
+struct MatrixEffect {
+    const char *name;
+    void (*start)(Matrix &matrix);
+    void (*render)(Matrix &matrix);
+    uint32_t duration;      // ms, before MATRIX_EFFECT_JITTER
+    uint8_t weight;         // Relative chance of being picked next
+    uint8_t brightness;
+    uint8_t stripMode;
+};
+
+// The first effect is the one the goggles start with
+extern const MatrixEffect matrixEffects[];
+extern const uint8_t matrixEffectCount;
+
+#endif
@@ -0,0 +1,194 @@
+#include "Filterbank.h"
+#include "Hal.h"
+#include "Matrix.h"
+#include "MatrixEffect.h"
+#include "Strip.h"
+#include "graphics.h"
+
+#define VISUALIZE_DURATION      60000
+#define COLOR_SWIRL_DURATION    15000
+#define EYES_DURATION           10000
+#define TEXT_DURATION           8000
+#define HEART_DURATION          10000
+#define BEER_DURATION           1000
+
+#define BEER_FRAMES 1
+const Sprite *beerAnimation[] = {
+    &BEER, &BEER
+};
+
+#define COLOR_SWIRL_FRAMES 8
+const Sprite *colorSwirlAnimation[] = {
+    &COLOR_SWIRL_1_LEFT, &COLOR_SWIRL_1_RIGHT,
+    &COLOR_SWIRL_1_LEFT, &COLOR_SWIRL_1_RIGHT,
+    &COLOR_SWIRL_2_LEFT, &COLOR_SWIRL_2_RIGHT,
+    &COLOR_SWIRL_2_LEFT, &COLOR_SWIRL_2_RIGHT,
+    &COLOR_SWIRL_3_LEFT, &COLOR_SWIRL_3_RIGHT,
+    &COLOR_SWIRL_3_LEFT, &COLOR_SWIRL_3_RIGHT,
+    &COLOR_SWIRL_4_LEFT, &COLOR_SWIRL_4_RIGHT,
+    &COLOR_SWIRL_4_LEFT, &COLOR_SWIRL_4_RIGHT
+};
+
+// Display columns from spectrum bins, generated at compile time (Filterbank.h)
+static constexpr Filterbank<16, Visualizer::analysisBins, Visualizer::fftSize, Visualizer::sampleRate, COLUMN_SCALE>
+    columnFilterbank = makeFilterbank<16, Visualizer::analysisBins, Visualizer::fftSize, Visualizer::sampleRate, COLUMN_SCALE>();
+
+static uint8_t dotCounter;
+static uint8_t peak[16];
+static q15_t columnLevels[16];          // Q15, the analysis already takes care of the gain
+static uint32_t columnScratch[16 + 1];
+static uint32_t lastSequence;
+
+static uint8_t animationFrame;
+
+static uint8_t eyeDirection;
+static uint32_t lastBlink;
+
+static void startNothing(Matrix &matrix) {
+}
+
+static void drawBars(Matrix &matrix) {
+    matrix.fillRGB(0, 0, 16, 3, matrix.getColor(PALETTE_HIGH));
+    matrix.fillRGB(0, 3, 16, 2, matrix.getColor(PALETTE_MEDIUM));
+    matrix.fillRGB(0, 5, 16, 3, matrix.getColor(PALETTE_LOW));
+}
+
+static void visualize(Matrix &matrix) {
+    drawBars(matrix);
+
+    const Visualizer::Frame &frame = matrix.getFrame();
+    uint8_t c, x, y;
+
+    // Column levels only change with a new analysis frame
+    if (frame.sequence != lastSequence) {
+        lastSequence = frame.sequence;
+        applyFilterbank(columnFilterbank, frame.smoothed, columnScratch, columnLevels);
+    }
+
+    for (x = 0; x < 16; x++) {
+        // Taking 32767 as 1, so full scale lights the top row
+        c = (((uint32_t)columnLevels[x] + 1) * MATRIX_SIZE) >> 15;
+
+        if (c > peak[x]) peak[x] = c;
+
+        if (peak[x] <= 0) {
+            matrix.fillRGB(x, 0, 1, 8, 0);
+            continue;
+        } else if (c < 8) {
+            matrix.fillRGB(x, 0, 1, 8 - c, 0);
+        }
+
+        y = 8 - peak[x];
+        if (y < 2) {
+            matrix.setPixelRGB(x, y, matrix.getColor(PALETTE_HIGH));
+        } else if (y < 6) {
+            matrix.setPixelRGB(x, y, matrix.getColor(PALETTE_MEDIUM));
+        } else {
+            matrix.setPixelRGB(x, y, matrix.getColor(PALETTE_LOW));
+        }
+    }
+
+    if (++dotCounter >= 1) {
+        dotCounter = 0;
+        for (x = 0; x < 16; x++) {
+            if (peak[x] > 0) peak[x]--;
+        }
+    }
+
+    matrix.advancePalette(1);
+}
+
+static void startAnimation(Matrix &matrix) {
+    animationFrame = 0;
+}
+
+// One animation frame per matrix frame
+static void animate(Matrix &matrix, const Sprite *frames[], uint8_t numberOfFrames) {
+    animationFrame++;
+    if (animationFrame >= numberOfFrames) {
+        animationFrame = 0;
+    }
+
+    matrix.drawPictures(frames, animationFrame);
+}
+
+static void colorSwirl(Matrix &matrix) {
+    animate(matrix, colorSwirlAnimation, COLOR_SWIRL_FRAMES);
+}
+
+static void beer(Matrix &matrix) {
+    animate(matrix, beerAnimation, BEER_FRAMES);
+}
+
+static void startEyes(Matrix &matrix) {
+    lastBlink = matrix.getTime();
+}
+
+static void renderEyes(Matrix &matrix) {
+    uint32_t now = matrix.getTime();
+
+    uint8_t shouldChange = halRandom(eyeDirection == 0 ? 4 : 16);
+    if (shouldChange == 0) {
+        eyeDirection = halRandom(12) + 1;
+    }
+
+    if (now - lastBlink > 2000) {
+        uint8_t shouldBlink = halRandom(max(1, 2000 - (now - lastBlink)));
+        if (shouldBlink == 0) {
+            eyeDirection = 0;
+            lastBlink = now;
+        }
+    }
+
+    switch (eyeDirection) {
+        case 0:
+            matrix.drawPicture(EYE_BLINK);
+            break;
+        case 1:
+            matrix.drawPicture(EYE_LEFT);
+            break;
+        case 2:
+            matrix.drawPicture(EYE_RIGHT);
+            break;
+        case 3:
+            matrix.drawPicture(EYE_UP);
+            break;
+        case 4:
+            matrix.drawPicture(EYE_DOWN);
+            break;
+        case 5:
+            lastBlink = now;
+            matrix.drawPicture(EYE_BLINK);
+            break;
+        default:
+            matrix.drawPicture(EYE_CENTER);
+            break;
+    }
+}
+
+static void startText(Matrix &matrix) {
+    matrix.restartText();
+}
+
+static void writeText(Matrix &matrix) {
+    matrix.drawText();
+}
+
+static void drawHearts(Matrix &matrix) {
+    matrix.drawSpriteMask(0, 0, HEART, matrix.getColor(PALETTE_HEART));
+    matrix.drawSpriteMask(8, 0, HEART, matrix.getColor(PALETTE_HEART));
+
+    matrix.advancePalette(16);
+}
+
+const MatrixEffect matrixEffects[] = {
+    // name            start             render          duration                weight  brightness  strip
+    { "visualize",    startNothing,     visualize,      VISUALIZE_DURATION,     12,     84,         STRIP_HISTORY },
+    { "color swirl",  startAnimation,   colorSwirl,     COLOR_SWIRL_DURATION,   3,      48,         STRIP_RAINBOW },
+    { "eyes",         startEyes,        renderEyes,     EYES_DURATION,          3,      72,         STRIP_PULSE },
+    { "text",         startText,        writeText,      TEXT_DURATION,          3,      192,        STRIP_METER },
+    { "hearts",       startNothing,     drawHearts,     HEART_DURATION,         3,      96,         STRIP_PULSE },
+    { "beer",         startAnimation,   beer,           BEER_DURATION,          2,      48,         STRIP_RAINBOW }
+};
+
+const uint8_t matrixEffectCount = sizeof(matrixEffects) / sizeof(matrixEffects[0]);
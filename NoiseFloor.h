@@ -0,0 +1,118 @@
+#ifndef _NOISE_FLOOR_H_
+#define _NOISE_FLOOR_H_
+
+/******************************************************************************
+
+Per bin noise floor by minimum statistics
+
+Each bin's magnitude is smoothed over a few frames, and the floor is the
+smallest smoothed value seen over the last NOISE_FLOOR_WINDOWS sub-windows of
+`framesPerWindow` frames, times NOISE_FLOOR_BIAS_NUM / NOISE_FLOOR_BIAS_DEN to
+make up for a minimum sitting below the mean of the noise. Music comes and
+goes, so its minimum is the room and the microphone; something steady for
+longer than all the sub-windows together ends up counted as noise.
+
+Only the running minimum of the current sub-window is touched every frame;
+the minimum over all of them is worked out again when a sub-window completes.
+T is q15_t for the fixed point analysis or float32_t, and everything stays in
+those units. The smoothing keeps a running sum of NOISE_FLOOR_SMOOTHING
+smoothed values in the promoted type, so with integers the fraction a frame
+adds is carried rather than truncated away and a steady input is met exactly.
+
+******************************************************************************/
+
+#include <stdint.h>
+
+#define NOISE_FLOOR_WINDOWS     4
+#define NOISE_FLOOR_SMOOTHING   8       // Frames, roughly
+// 3/2 as a fraction, so it works for integers
+#define NOISE_FLOOR_BIAS_NUM    3
+#define NOISE_FLOOR_BIAS_DEN    2
+
+template<typename T, int BINS>
+class NoiseFloor {
+    typedef decltype(T() * NOISE_FLOOR_SMOOTHING) sum_t;
+
+public:
+    NoiseFloor() {
+        framesPerWindow = 1;
+        reset();
+    }
+
+    void begin(uint16_t frames) {
+        framesPerWindow = frames > 0 ? frames : 1;
+        reset();
+    }
+
+    void reset() {
+        frames = 0;
+        window = 0;
+        started = false;
+        for (int i = 0; i < BINS; i++) {
+            smoothedSum[i] = 0;
+            minimum[i] = 0;
+        }
+    }
+
+    /**
+     * Take one frame of magnitudes into account
+     */
+    void update(const T *magnitudes) {
+        if (!started) {
+            // Start from the first frame rather than from silence
+            started = true;
+            for (int i = 0; i < BINS; i++) {
+                smoothedSum[i] = (sum_t)magnitudes[i] * NOISE_FLOOR_SMOOTHING;
+                windowMinimum[i] = magnitudes[i];
+                for (int w = 0; w < NOISE_FLOOR_WINDOWS; w++) {
+                    minima[w][i] = magnitudes[i];
+                }
+                minimum[i] = magnitudes[i];
+            }
+            return;
+        }
+
+        for (int i = 0; i < BINS; i++) {
+            smoothedSum[i] += magnitudes[i] - smoothedSum[i] / NOISE_FLOOR_SMOOTHING;
+            T smoothed = smoothedSum[i] / NOISE_FLOOR_SMOOTHING;
+            if (smoothed < windowMinimum[i]) {
+                windowMinimum[i] = smoothed;
+            }
+        }
+
+        if (++frames < framesPerWindow) {
+            return;
+        }
+        frames = 0;
+
+        for (int i = 0; i < BINS; i++) {
+            minima[window][i] = windowMinimum[i];
+            windowMinimum[i] = smoothedSum[i] / NOISE_FLOOR_SMOOTHING;
+
+            minimum[i] = minima[0][i];
+            for (int w = 1; w < NOISE_FLOOR_WINDOWS; w++) {
+                if (minima[w][i] < minimum[i]) {
+                    minimum[i] = minima[w][i];
+                }
+            }
+        }
+        window = (window + 1) % NOISE_FLOOR_WINDOWS;
+    }
+
+    // In the promoted type, so a Q15 floor can go past the Q15 range
+    auto floor(int bin) const -> decltype(T() * NOISE_FLOOR_BIAS_NUM) {
+        return minimum[bin] * NOISE_FLOOR_BIAS_NUM / NOISE_FLOOR_BIAS_DEN;
+    }
+
+private:
+    sum_t smoothedSum[BINS];
+    T windowMinimum[BINS];
+    T minima[NOISE_FLOOR_WINDOWS][BINS];
+    T minimum[BINS];
+    uint16_t framesPerWindow;
+    uint16_t frames;
+    uint8_t window;
+    bool started;
+};
+
+#endif
@@ -0,0 +1,78 @@
+#include "Palette.h"
+#include "gamma.h"
+
+static const uint32_t lowLevelColors[5] = { 0xD30DFF, 0x4E0FE8, 0x003AFF, 0x0CAEE8, 0x00FFBC };
+static const uint32_t mediumLevelColors[5] = { 0x2CFF0D, 0xBEE80F, 0xFFDC00, 0xE89F0C, 0xFF6C00 };
+static const uint32_t highLevelColors[5] = { 0xFF960D, 0xE84B00, 0xFF1400, 0xE80C88, 0xC800FF };
+static const uint32_t levelCycleColors[15] = {
+    0xFF960D, 0xE84B00, 0xFF1400, 0xE80C88, 0xC800FF,
+    0x2CFF0D, 0xBEE80F, 0xFFDC00, 0xE89F0C, 0xFF6C00,
+    0xD30DFF, 0x4E0FE8, 0x003AFF, 0x0CAEE8, 0x00FFBC
+};
+static constexpr uint32_t rainbowColors[3] = { 0x00FF00, 0xFF0000, 0x0000FF };
+
+const Gradient lowLevelGradient = { lowLevelColors, 5 };
+const Gradient mediumLevelGradient = { mediumLevelColors, 5 };
+const Gradient highLevelGradient = { highLevelColors, 5 };
+const Gradient levelCycleGradient = { levelCycleColors, 15 };
+const Gradient rainbowGradient = { rainbowColors, 3 };
+
+// lerpColor() and sampleGradient() as single-return C++11 constexpr, for tables
+constexpr uint32_t lerpColorConstant(uint32_t from, uint32_t to, uint32_t weight) {
+    return ((((from & 0xFF00FF) * (256 - weight) + (to & 0xFF00FF) * weight) >> 8) & 0xFF00FF) |
+           ((((from & 0x00FF00) * (256 - weight) + (to & 0x00FF00) * weight) >> 8) & 0x00FF00);
+}
+
+constexpr uint32_t rainbowEntry(uint32_t position) {
+    return lerpColorConstant(rainbowColors[(position >> 8) % 3], rainbowColors[((position >> 8) + 1) % 3], position & 0xFF);
+}
+
+template<int... I> struct ColorIndices {};
+template<int N, int... I> struct MakeColorIndices : MakeColorIndices<N - 1, N - 1, I...> {};
+template<int... I> struct MakeColorIndices<0, I...> { typedef ColorIndices<I...> type; };
+
+template<int... I>
+constexpr ColorTable makeRainbowTable(ColorIndices<I...>) {
+    return {{ rainbowEntry(I * 3)... }};
+}
+
+const ColorTable rainbowTable = makeRainbowTable(MakeColorIndices<256>::type());
+
+/**
+ * weight 0 is `from`, 255 is all but `to`
+ */
+uint32_t lerpColor(uint32_t from, uint32_t to, uint8_t weight) {
+    uint32_t inverse = 256 - weight;
+    uint32_t redBlue = ((from & 0xFF00FF) * inverse + (to & 0xFF00FF) * weight) >> 8;
+    uint32_t green = ((from & 0x00FF00) * inverse + (to & 0x00FF00) * weight) >> 8;
+
+    return (redBlue & 0xFF00FF) | (green & 0x00FF00);
+}
+
+uint32_t sampleGradient(const Gradient &gradient, uint16_t position) {
+    uint8_t stop = (position >> 8) % gradient.count;
+    uint8_t next = stop + 1 < gradient.count ? stop + 1 : 0;
+
+    return lerpColor(gradient.stops[stop], gradient.stops[next], position & 0xFF);
+}
+
+/**
+ * Fill `colors` with `count` samples, starting at `position` and `step` apart
+ */
+void sampleGradient(const Gradient &gradient, uint16_t position, uint16_t step, uint32_t *colors, uint8_t count) {
+    for (uint8_t i = 0; i < count; i++) {
+        colors[i] = sampleGradient(gradient, position);
+        position += step;
+    }
+}
+
+/**
+ * `color` at `level` of 255, through gamma8 like the matrix's 24-bit drawing
+ */
+uint32_t scaleColor(uint32_t color, uint8_t level) {
+    uint32_t scale = (uint32_t)pgm_read_byte(&gamma8[level]) + 1;
+    uint32_t redBlue = ((color & 0xFF00FF) * scale) >> 8;
+    uint32_t green = ((color & 0x00FF00) * scale) >> 8;
+
+    return (redBlue & 0xFF00FF) | (green & 0x00FF00);
+}
@@ -0,0 +1,53 @@
+#ifndef _PALETTE_H_
+#define _PALETTE_H_
+
+/******************************************************************************
+
+Colour gradients in integer maths
+
+A Gradient is a cycle of evenly spaced 0xRRGGBB stops. Positions along it
+are 8.8 fixed point in stops: the high byte picks the stop (wrapping round),
+the low byte is how far it is towards the next one. Blending is an 8-bit
+lerp with red and blue done together in one 32-bit multiply, so there is no
+float anywhere.
+
+Renderers are meant to sample what they need once a frame into a small table
+and index that per pixel, rather than blend colours inside pixel loops. The
+rainbow the strip runs on is such a table already, 256 entries generated by
+the compiler into flash, and scaleColor() dims a colour through the gamma8
+table so levels drawn with it look even to the eye.
+
+******************************************************************************/
+
+#include <Arduino.h>
+
+struct Gradient {
+    const uint32_t *stops;
+    uint8_t count;
+};
+
+// Level colours for the visualizer bars, from the bottom up
+extern const Gradient lowLevelGradient;
+extern const Gradient mediumLevelGradient;
+extern const Gradient highLevelGradient;
+// All three level sets one after another, high to low
+extern const Gradient levelCycleGradient;
+// Green, red, blue and back, like the classic NeoPixel colour wheel
+extern const Gradient rainbowGradient;
+
+// rainbowGradient at 3/256 of a stop an entry, so the table is the full cycle
+struct ColorTable {
+    uint32_t colors[256];
+};
+extern const ColorTable rainbowTable;
+
+inline uint32_t rainbowColor(uint8_t index) {
+    return rainbowTable.colors[index];
+}
+
+uint32_t lerpColor(uint32_t from, uint32_t to, uint8_t weight);
+uint32_t sampleGradient(const Gradient &gradient, uint16_t position);
+void sampleGradient(const Gradient &gradient, uint16_t position, uint16_t step, uint32_t *colors, uint8_t count);
+uint32_t scaleColor(uint32_t color, uint8_t level);
+
+#endif
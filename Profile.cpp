@@ -0,0 +1,29 @@
+#include "Hal.h"
+#include "Profile.h"
+
+ProfileStage profileStages[PROFILE_STAGES];
+
+uint32_t profileStart() {
+    return halProfileCycles();
+}
+
+void profileEnd(uint8_t stage, uint32_t start) {
+    uint32_t elapsed = halProfileCycles() - start;
+    ProfileStage &profile = profileStages[stage];
+
+    profile.count++;
+    profile.totalCycles += elapsed;
+    if (elapsed > profile.worstCycles) {
+        profile.worstCycles = elapsed;
+    }
+}
+
+const ProfileStage& profileStage(uint8_t stage) {
+    return profileStages[stage];
+}
+
+void profileReset() {
+    for (uint8_t i = 0; i < PROFILE_STAGES; i++) {
+        profileStages[i] = ProfileStage();
+    }
+}
@@ -0,0 +1,42 @@
+#ifndef _PROFILE_H_
+#define _PROFILE_H_
+
+/******************************************************************************
+
+Execution time of the stages of a frame
+
+A stage is timed by taking profileStart() before it and handing that to
+profileEnd() after it. Per stage this keeps the number of runs and the total
+and worst time in CPU cycles (halProfileCycles()); telemetry reports them. On
+the M0 those are counted by SysTick, so they are the goggles' own cycle
+counts, good to the few dozen cycles reading the counter takes. On the host
+they are its real clock in the same units, which ranks code but is no cycle
+count for the M0.
+
+Stages nest: render includes the show() calls made from it, and fft the
+spectrum, so the spectrum on its own is what the kernel benchmarks of the
+FFT and magnitudes stand in for on the host.
+
+******************************************************************************/
+
+#include <stdint.h>
+
+#define PROFILE_CAPTURE     0   // Taking the block out of the capture buffer
+#define PROFILE_FFT         1   // Spectrum, levels and onset detection
+#define PROFILE_RENDER      2   // Matrix and Strip frames
+#define PROFILE_SHOW        3   // Encoding and submitting pixel frames
+#define PROFILE_SPECTRUM    4   // Windowing, FFT and magnitudes
+#define PROFILE_STAGES      5
+
+struct ProfileStage {
+    uint32_t count;
+    uint64_t totalCycles;
+    uint32_t worstCycles;
+};
+
+uint32_t profileStart();
+void profileEnd(uint8_t stage, uint32_t start);
+const ProfileStage& profileStage(uint8_t stage);
+void profileReset();
+
+#endif
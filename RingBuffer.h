@@ -0,0 +1,132 @@
+#ifndef _RING_BUFFER_H_
+#define _RING_BUFFER_H_
+
+/******************************************************************************
+
+Fixed capacity history with running statistics
+
+RingBuffer<T, N> keeps the last N values pushed, in static storage, and keeps
+their sum, sum of squares and maximum up to date as values come and go, so
+reading any of them is O(1) instead of a walk over the history.
+
+Sums are kept in A (T by default). For floating point the running sums pick
+up rounding error as values are added and taken away, so they are recomputed
+from the stored values every N pushes, which keeps that O(1) amortised. The
+maximum uses a queue of candidates: values that can still become the
+maximum once everything older has left.
+
+******************************************************************************/
+
+#include <stdint.h>
+
+template<typename T, int N, typename A = T>
+class RingBuffer {
+public:
+    RingBuffer() {
+        clear();
+    }
+
+    void clear() {
+        head = 0;
+        count = 0;
+        pushes = 0;
+        total = 0;
+        squares = 0;
+        maximumHead = 0;
+        maximumCount = 0;
+    }
+
+    /**
+     * Add a value, dropping the oldest one once the buffer is full
+     */
+    void push(T value) {
+        if (count == N) {
+            T oldest = values[head];
+            total -= oldest;
+            squares -= (A)oldest * oldest;
+            if (maximumCount > 0 && maximumQueue[maximumHead] == head) {
+                maximumHead = (maximumHead + 1) % N;
+                maximumCount--;
+            }
+        } else {
+            count++;
+        }
+
+        values[head] = value;
+        total += value;
+        squares += (A)value * value;
+
+        // Anything not larger than the new value can never be the maximum again
+        while (maximumCount > 0 && values[maximumQueue[(maximumHead + maximumCount - 1) % N]] <= value) {
+            maximumCount--;
+        }
+        maximumQueue[(maximumHead + maximumCount) % N] = head;
+        maximumCount++;
+
+        head = (head + 1) % N;
+
+        if (++pushes >= N) {
+            pushes = 0;
+            total = 0;
+            squares = 0;
+            for (uint16_t i = 0; i < count; i++) {
+                total += values[i];
+                squares += (A)values[i] * values[i];
+            }
+        }
+    }
+
+    // i = 0 is the oldest value
+    T at(uint16_t i) const {
+        return values[(head + N - count + i) % N];
+    }
+
+    T newest() const {
+        return values[(head + N - 1) % N];
+    }
+
+    uint16_t size() const {
+        return count;
+    }
+
+    bool full() const {
+        return count == N;
+    }
+
+    A sum() const {
+        return total;
+    }
+
+    A mean() const {
+        return count > 0 ? total / count : 0;
+    }
+
+    A variance() const {
+        if (count == 0) {
+            return 0;
+        }
+
+        A average = total / count;
+        A difference = squares / count - average * average;
+        return difference > 0 ? difference : 0;
+    }
+
+    T maximum() const {
+        return maximumCount > 0 ? values[maximumQueue[maximumHead]] : 0;
+    }
+
+private:
+    T values[N];
+    uint16_t head;
+    uint16_t count;
+    uint16_t pushes;
+    A total;
+    A squares;
+
+    // Positions in values of the maximum candidates, oldest (and largest) first
+    uint16_t maximumQueue[N];
+    uint16_t maximumHead;
+    uint16_t maximumCount;
+};
+
+#endif
@@ -0,0 +1,145 @@
+#include "Scheduler.h"
+
+Scheduler::Scheduler() {
+    taskCount = 0;
+    tickMicros = 0;
+    tickMillis = 0;
+    statsStart = 0;
+    busyTime = 0;
+    idleTime = 0;
+    idleStart = 0;
+    idle = false;
+}
+
+/**
+ * Register a task, first release on the next tick. Returns its index, or -1
+ * if SCHEDULER_TASKS are already taken.
+ */
+int8_t Scheduler::add(const char *name, SchedulerTask task, uint32_t period, uint32_t deadline) {
+    if (taskCount >= SCHEDULER_TASKS) {
+        return -1;
+    }
+
+    tasks[taskCount] = task;
+    nextRelease[taskCount] = halMicros();
+    stats[taskCount] = SchedulerStats();
+    stats[taskCount].name = name;
+    stats[taskCount].period = period;
+    stats[taskCount].deadline = deadline;
+
+    return taskCount++;
+}
+
+void Scheduler::resetStats() {
+    statsStart = halMicros();
+    busyTime = 0;
+    idleTime = 0;
+    for (uint8_t i = 0; i < taskCount; i++) {
+        stats[i].runs = 0;
+        stats[i].worstTime = 0;
+        stats[i].totalTime = 0;
+        stats[i].worstLateness = 0;
+        stats[i].totalLateness = 0;
+        stats[i].missed = 0;
+        stats[i].dropped = 0;
+    }
+}
+
+bool Scheduler::releaseDue(uint32_t time) {
+    for (uint8_t i = 0; i < taskCount; i++) {
+        if (stats[i].period > 0 && (int32_t)(time - nextRelease[i]) >= 0) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void Scheduler::loop() {
+    tickMicros = halMicros();
+    tickMillis = halMillis();
+
+    // Back from halIdle(), however long ago that returned
+    if (idle) {
+        idleTime += tickMicros - idleStart;
+        idle = false;
+    }
+
+    for (uint8_t i = 0; i < taskCount; i++) {
+        SchedulerStats &task = stats[i];
+        uint32_t release = tickMicros;
+
+        if (task.period > 0) {
+            if ((int32_t)(tickMicros - nextRelease[i]) < 0) {
+                continue;
+            }
+
+            release = nextRelease[i];
+            nextRelease[i] += task.period;
+            while ((int32_t)(tickMicros - nextRelease[i]) >= 0) {
+                nextRelease[i] += task.period;
+                task.dropped++;
+            }
+        }
+
+        uint32_t lateness = tickMicros - release;
+        uint32_t start = halProfileMicros();
+        bool worked = tasks[i](tickMillis);
+        uint32_t elapsed = halProfileMicros() - start;
+        if (!worked) {
+            continue;
+        }
+
+        task.runs++;
+        task.totalTime += elapsed;
+        busyTime += elapsed;
+        if (elapsed > task.worstTime) {
+            task.worstTime = elapsed;
+        }
+        task.totalLateness += lateness;
+        if (lateness > task.worstLateness) {
+            task.worstLateness = lateness;
+        }
+
+        // Late start plus the time it took, against the deadline from release
+        if (lateness + elapsed > task.deadline) {
+            task.missed++;
+        }
+    }
+
+    // Nothing to do until an interrupt: a block landing or the next system tick
+    uint32_t time = halMicros();
+    if (!releaseDue(time)) {
+        idleStart = time;
+        idle = halIdle();
+    }
+}
+
+uint32_t Scheduler::getTickMicros() {
+    return tickMicros;
+}
+
+uint32_t Scheduler::getTickMillis() {
+    return tickMillis;
+}
+
+uint8_t Scheduler::getTaskCount() {
+    return taskCount;
+}
+
+const SchedulerStats& Scheduler::getStats(uint8_t task) {
+    return stats[task];
+}
+
+// Since the last resetStats(), or boot
+uint32_t Scheduler::getElapsedTime() {
+    return halMicros() - statsStart;
+}
+
+uint32_t Scheduler::getBusyTime() {
+    return busyTime;
+}
+
+uint32_t Scheduler::getIdleTime() {
+    return idleTime;
+}
@@ -0,0 +1,91 @@
+#ifndef _SCHEDULER_H_
+#define _SCHEDULER_H_
+
+/******************************************************************************
+
+Cooperative fixed-rate scheduler
+
+Each subsystem registers a task with a period and a deadline, both in
+microseconds. Every loop() takes one timestamp for the whole tick and runs,
+in registration order, each task whose release time has come. Tasks with a
+period of 0 are polled on every tick and return whether there was anything to
+do; only the polls that did work count in their statistics, so an idle poll
+is neither a run nor a miss.
+
+Releases are fixed-rate: the next one is the previous release plus the period,
+not "now" plus the period, so pacing does not drift with execution time. A
+task that falls more than a period behind drops the releases it missed rather
+than running back to back to catch up.
+
+Per task the scheduler keeps the worst-case and total execution time (from
+halProfileMicros()), the worst and total lateness of the start against the
+release (the jitter of periodic tasks), the releases that finished after
+their deadline and the releases that were dropped.
+
+When a tick leaves nothing to do, no release due and no captured block
+waiting, the scheduler sleeps in halIdle() until the next interrupt. It
+accounts for the time since the last resetStats() in three states: running
+tasks (busy), asleep (idle), and everything else (the scheduler itself and
+interrupts). All times are 32 bit microseconds and wrap after 71 minutes, so
+take duty cycles from differences between two readings.
+
+******************************************************************************/
+
+#include <Arduino.h>
+
+#include "Hal.h"
+
+#define SCHEDULER_TASKS     4
+
+// Called with halMillis() as it was at the start of the tick. Returns false
+// when a poll found nothing to do, see above.
+typedef bool (*SchedulerTask)(uint32_t now);
+
+struct SchedulerStats {
+    const char *name;
+    uint32_t period;
+    uint32_t deadline;
+    uint32_t runs;
+    uint32_t worstTime;
+    uint32_t totalTime;
+    uint32_t worstLateness;
+    uint32_t totalLateness;
+    uint32_t missed;
+    uint32_t dropped;
+};
+
+class Scheduler {
+public:
+    Scheduler();
+
+    int8_t add(const char *name, SchedulerTask task, uint32_t period, uint32_t deadline);
+    void loop();
+
+    uint32_t getTickMicros();
+    uint32_t getTickMillis();
+    uint8_t getTaskCount();
+    const SchedulerStats& getStats(uint8_t task);
+    void resetStats();
+
+    uint32_t getElapsedTime();
+    uint32_t getBusyTime();
+    uint32_t getIdleTime();
+
+private:
+    SchedulerTask tasks[SCHEDULER_TASKS];
+    uint32_t nextRelease[SCHEDULER_TASKS];
+    SchedulerStats stats[SCHEDULER_TASKS];
+    uint8_t taskCount;
+    uint32_t tickMicros;
+    uint32_t tickMillis;
+
+    uint32_t statsStart;
+    uint32_t busyTime;
+    uint32_t idleTime;
+    uint32_t idleStart;
+    bool idle;
+
+    bool releaseDue(uint32_t time);
+};
+
+#endif
@@ -0,0 +1,85 @@
+#include <math.h>
+
+#include "FixedPoint.h"
+#include "SlidingDFT.h"
+
+#define TWIDDLE_BITS    12
+#define TWIDDLE_ONE     (1 << TWIDDLE_BITS)
+#define DAMPING         0.999
+
+// |S| is at most N * 2544 (a full scale ADC reading around the midpoint),
+// under 2^18, so products with Q12 twiddles stay inside 31 bits. Magnitudes
+// are taken on S / 8 so the squares fit too, then scaled to the units of
+// arm_cmplx_mag_q15 after an N point arm_rfft_q15:
+//     |S| * 32768 / (N * (MICROPHONE_HIGH - MICROPHONE_LOW))
+#define MAGNITUDE_SHIFT 3
+#define MAGNITUDE_Q16   ((uint32_t)((8ULL * 32768 * 65536) / (N * (MICROPHONE_HIGH - MICROPHONE_LOW))))
+
+template<int N>
+SlidingDFT<N>::SlidingDFT() {
+    // Twiddles are only worked out once, with the damping folded in
+    for (int k = 0; k < SLIDING_DFT_BINS; k++) {
+        twiddleReal[k] = (int16_t)floor(DAMPING * cos(2.0 * PI * k / N) * TWIDDLE_ONE + 0.5);
+        twiddleImaginary[k] = (int16_t)floor(DAMPING * sin(2.0 * PI * k / N) * TWIDDLE_ONE + 0.5);
+    }
+
+    dampingN = (int16_t)floor(pow(DAMPING, N) * TWIDDLE_ONE + 0.5);
+
+    reset();
+}
+
+template<int N>
+void SlidingDFT<N>::reset() {
+    for (int i = 0; i < N; i++) {
+        history[i] = 0;
+    }
+
+    for (int k = 0; k < SLIDING_DFT_BINS; k++) {
+        real[k] = 0;
+        imaginary[k] = 0;
+    }
+
+    historyIndex = 0;
+}
+
+template<int N>
+void SlidingDFT<N>::update(const volatile uint16_t *samples, uint16_t count) {
+    for (uint16_t i = 0; i < count; i++) {
+        int32_t sample = (int32_t)samples[i] - MICROPHONE_MIDPOINT;
+        int32_t delta = sample - ((history[historyIndex] * dampingN + TWIDDLE_ONE / 2) >> TWIDDLE_BITS);
+
+        history[historyIndex] = sample;
+        if (++historyIndex >= N) {
+            historyIndex = 0;
+        }
+
+        for (int k = 0; k < SLIDING_DFT_BINS; k++) {
+            int32_t re = real[k] + delta;
+            int32_t im = imaginary[k];
+
+            real[k] = (re * twiddleReal[k] - im * twiddleImaginary[k] + TWIDDLE_ONE / 2) >> TWIDDLE_BITS;
+            imaginary[k] = (re * twiddleImaginary[k] + im * twiddleReal[k] + TWIDDLE_ONE / 2) >> TWIDDLE_BITS;
+        }
+    }
+}
+
+/**
+ * Magnitudes of the tracked bins, in the same units as arm_cmplx_mag_q15
+ */
+template<int N>
+void SlidingDFT<N>::getMagnitudes(q15_t *magnitudes) {
+    for (int k = 0; k < SLIDING_DFT_BINS; k++) {
+        int32_t re = real[k] >> MAGNITUDE_SHIFT;
+        int32_t im = imaginary[k] >> MAGNITUDE_SHIFT;
+        uint32_t magnitude = (squareRoot((uint32_t)(re * re) + (uint32_t)(im * im)) * MAGNITUDE_Q16) >> 16;
+
+        magnitudes[k] = (q15_t)(magnitude > 32767 ? 32767 : magnitude);
+    }
+}
+
+// The largest size, which goggles-bench times whatever the build; the linker
+// drops it from firmware that does not use it
+template class SlidingDFT<64>;
+#if defined(SLIDING_DFT_ANALYSIS) && FFT_SAMPLES != 64
+template class SlidingDFT<FFT_SAMPLES>;
+#endif
@@ -0,0 +1,42 @@
+#ifndef _SLIDING_DFT_H_
+#define _SLIDING_DFT_H_
+
+#include <arm_math.h>
+
+#include "constants.h"
+
+/**
+ *  Damped sliding DFT over the last N samples, for bins
+ *  0..SLIDING_DFT_BINS - 1 only.
+ *
+ *  Every sample costs one complex multiply per bin, all in 32-bit integers:
+ *
+ *      S(n) = r * W * (S(n - 1) + x(n) - r^N * x(n - N))
+ *
+ *  The damping r keeps rounding errors in the Q12 twiddles from accumulating;
+ *  it tapers the window by about 6% at the oldest sample (for N = 64).
+ */
+template<int N>
+class SlidingDFT {
+    // |S| reaches N * 2544, which has to stay under 2^18 for the Q12 products
+    static_assert(N <= 64, "The sliding DFT only keeps 32 bit products up to 64 samples");
+    static_assert(SLIDING_DFT_BINS <= N / 2, "More sliding DFT bins than the spectrum has");
+
+public:
+    SlidingDFT();
+
+    void reset();
+    void update(const volatile uint16_t *samples, uint16_t count);
+    void getMagnitudes(q15_t *magnitudes);
+
+private:
+    int16_t history[N];
+    uint8_t historyIndex;
+    int32_t real[SLIDING_DFT_BINS];
+    int32_t imaginary[SLIDING_DFT_BINS];
+    int16_t twiddleReal[SLIDING_DFT_BINS];
+    int16_t twiddleImaginary[SLIDING_DFT_BINS];
+    int16_t dampingN;
+};
+
+#endif
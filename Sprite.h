@@ -0,0 +1,41 @@
+#ifndef _SPRITE_H_
+#define _SPRITE_H_
+
+/******************************************************************************
+
+Sprite format
+
+Sprites live in flash and are generated from the PNGs in bitmaps/ by
+host/tools/sprites.py (see graphics.h). The data starts with a 3 byte header:
+
+    width, height, encoding
+
+    SPRITE_RAW       width * height * 3 bytes of RGB, rows top to bottom
+    SPRITE_INDEXED   number of colours P (1..SPRITE_MAX_COLORS), P * 3 bytes
+                     of RGB palette, then runs of one palette index in the
+                     same pixel order. With P <= 16 a run is one byte, length
+                     - 1 in the high nibble and the index in the low one;
+                     otherwise it is two bytes, length - 1 then the index.
+                     Index 0 is black whenever the image has any black.
+
+A Sprite is that data plus mirror flags, so a mirror image of another sprite
+costs no flash of its own. Matrix::drawSprite() decodes the stream straight
+into the pixel buffer.
+
+******************************************************************************/
+
+#include <Arduino.h>
+
+#define SPRITE_RAW          0
+#define SPRITE_INDEXED      1
+#define SPRITE_MAX_COLORS   64
+
+#define SPRITE_MIRROR_X     0x01
+#define SPRITE_MIRROR_Y     0x02
+
+struct Sprite {
+    const uint8_t *data;
+    uint8_t flags;
+};
+
+#endif
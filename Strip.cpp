@@ -1,14 +1,14 @@
 #include <Adafruit_DotStar.h>
 
+#include "Hal.h"
+#include "Palette.h"
+#include "Profile.h"
 #include "Strip.h"
 
-#define FRAME_DURATION 8
-
 Strip::Strip()
-    : Adafruit_DotStar(LED_STRIP_PIXELS, LED_STRIP_DATA_PIN, LED_STRIP_CLOCK_PIN, DOTSTAR_BRG)
+    : DotStarOutput(LED_STRIP_PIXELS, LED_STRIP_DATA_PIN, LED_STRIP_CLOCK_PIN, DOTSTAR_BRG)
 {
     brightness = 16;
-    largestRead = 1;
 }
 
 uint32_t Strip::Color(uint8_t red, uint8_t green, uint8_t blue)
@@ -16,85 +16,210 @@ uint32_t Strip::Color(uint8_t red, uint8_t green, uint8_t blue)
     return ((uint32_t)green << 16) | ((uint32_t)red << 8) | blue;
 }
 
-uint32_t Wheel(byte WheelPos) {
-    if(WheelPos < 85) {
-        return Strip::Color(WheelPos * 3, 255 - WheelPos * 3, 0);
-    } else if(WheelPos < 170) {
-        WheelPos -= 85;
-        return Strip::Color(255 - WheelPos * 3, 0, WheelPos * 3);
-    } else {
-        WheelPos -= 170;
-        return Strip::Color(0, WheelPos * 3, 255 - WheelPos * 3);
-    }
-}
-
-void Strip::initialize(AudioVisualizer pVisualizer) {
-    visualizer = pVisualizer;
-    lastBeat = millis();
+void Strip::initialize(const Visualizer &pVisualizer, const Matrix &pMatrix) {
+    visualizer = &pVisualizer;
+    matrix = &pMatrix;
+    now = halMillis();
+    lastBeat = halMillis();
+    lastSequence = visualizer->getFrame().sequence;
+    lastOnset = visualizer->getFrame().onsetTime;
 
     begin();
     setBrightness(8);
     clear();
     show();
 
-    lastTime = millis();
+    // Nothing to fade in from yet
+    startMode(matrix->getStripMode());
+    fading = false;
 }
 
-void Strip::loop() {
+void Strip::loop(uint32_t tickTime) {
+    uint32_t renderStart = profileStart();
+    now = tickTime;
     calculateBeat();
-    cycle();
 
+    if (matrix->getStripMode() != mode) {
+        startMode(matrix->getStripMode());
+    }
+
+    switch (mode) {
+        case STRIP_METER:
+            meter();
+            break;
+        case STRIP_PULSE:
+            pulse();
+            break;
+        case STRIP_HISTORY:
+            scroll();
+            break;
+        default:
+            cycle();
+            break;
+    }
+
+    uint8_t targetBrightness = mode == STRIP_RAINBOW ? brightness : STRIP_BRIGHTNESS;
+    if (fading) {
+        crossfade(targetBrightness);
+    } else {
+        setBrightness(targetBrightness);
+    }
     show();
+    profileEnd(PROFILE_RENDER, renderStart);
 }
 
-void Strip::calculateBeat() {
-    float32_t *output = visualizer.getEqualizedOutput();
+/**
+ * Brighter the more this onset stands out from the recent ones
+ */
+uint8_t Strip::scoreOnset(float32_t strength) {
+    onsetStrengths.push(strength);
+    float32_t spread = sqrt(onsetStrengths.variance());
+    float32_t score = spread > 0 ? (strength - onsetStrengths.mean()) / spread : 0;
+    float32_t middle = (STRIP_BEAT_BRIGHTEST + STRIP_BEAT_DIMMEST) / 2.0f;
+    float32_t perDeviation = (STRIP_BEAT_BRIGHTEST - STRIP_BEAT_DIMMEST) / 2.0f / STRIP_BEAT_SPREAD;
+    return constrain(round(middle + perDeviation * score), STRIP_BEAT_DIMMEST, STRIP_BEAT_BRIGHTEST);
+}
 
-    float32_t reads[previousReads.size()];
-    for (int i = 0; i < previousReads.size(); i++) {
-        reads[i] = previousReads.at(i);
-    }
-    float32_t avg = 1;
-    arm_mean_f32(reads, previousReads.size(), &avg);
+void Strip::calculateBeat() {
+    const Visualizer::Frame &frame = visualizer->getFrame();
+    bool newOnset = frame.sequence != lastSequence && frame.onsetTime != lastOnset;
+    lastSequence = frame.sequence;
 
-    float32_t sample = output[0] + output[1];
-    float32_t threshold = max(largestRead * 0.8, (avg * 1.5));
+    // The onset may be from a frame in between, so go by its time
+    if (newOnset) {
+        lastOnset = frame.onsetTime;
 
-    if (sample > threshold) {
-        uint8_t nextBrightness = min(228, max(64, round(255 * ((sample - avg) / sample))));
-        position += round((millis() - lastBeat) / 1000) + random(5, 15);
-        lastBeat = millis();
+        uint8_t nextBrightness = scoreOnset(frame.onsetStrength);
+        position += round((now - lastBeat) / 1000) + halRandom(5, 15);
+        lastBeat = now;
         if (nextBrightness > brightness) {
             brightness = nextBrightness;
         }
     } else {
-        largestRead = max(0.5, largestRead - 0.05);
         brightness = max(16, brightness - 20);
     }
+}
+
+/**
+ * Keep the frame on the strip to fade out of, and start the new mode from
+ * nothing
+ */
+void Strip::startMode(uint8_t index) {
+    memcpy(fadePixels, getPixels(), sizeof(fadePixels));
+    fadeBrightness = getBrightness();
+    fadeStart = now;
+    fading = true;
+
+    mode = index;
+    meterLevel = 0;
+    meterPeak = 0;
+    pulseLevel = 0;
+    nextScroll = now;
+    memset(history, 0, sizeof(history));
+}
 
-    if (previousReads.size() == 64) {
-        previousReads.pop_front();
+void Strip::cycle() {
+    // One rainbow step a pixel, three steps to a stop like the old colour wheel
+    uint8_t index;
+    for (index = 0; index < LED_STRIP_PIXELS; index++) {
+        setPixelRGB(index, rainbowColor(position + index));
     }
 
-    if (sample > largestRead) {
-        largestRead = sample;
+    position++;
+}
+
+/**
+ * Lit from the first pixel up by the loudest band, the whole strip at 1,
+ * green through yellow to red, the top pixel partly, and a peak dot that
+ * falls back more slowly
+ */
+void Strip::meter() {
+    const Visualizer::Frame &frame = visualizer->getFrame();
+    uint16_t level = (((uint32_t)frame.maximumValue + 1) * LED_STRIP_PIXELS * 256) >> 15;
+
+    // Straight up, and back down at a pixel in 64 ms, the peak in 512 ms
+    meterLevel = max(level, meterLevel > 32 ? meterLevel - 32 : 0);
+    meterPeak = max(meterLevel, meterPeak > 4 ? meterPeak - 4 : 0);
+    uint8_t top = meterLevel >> 8;
+    uint8_t peak = meterPeak >> 8;
+
+    uint8_t index;
+    for (index = 0; index < LED_STRIP_PIXELS; index++) {
+        uint32_t color = rainbowColor(index * 85 / (LED_STRIP_PIXELS - 1));
+        if (index < top) {
+            setPixelRGB(index, color);
+        } else if (index == top) {
+            setPixelRGB(index, scaleColor(color, meterLevel & 0xFF));
+        } else if (index == peak) {
+            setPixelRGB(index, color);
+        } else {
+            setPixelRGB(index, 0);
+        }
     }
+}
 
-    previousReads.push_back(sample);
+/**
+ * The bass level as far out from the two middle pixels as it reaches, dimmer
+ * further out, in a colour from the bass frequency
+ */
+void Strip::pulse() {
+    const Visualizer::Frame &frame = visualizer->getFrame();
+    uint8_t level = (((uint32_t)frame.bassPeakValue + 1) * 255) >> 15;
+    pulseLevel = max(level, pulseLevel > 8 ? pulseLevel - 8 : 0);
+
+    // 30..180Hz from red to blue; the frequency is in Hz * 16
+    uint8_t hue = 85 + constrain(((int32_t)frame.bassPeakFrequency - 30 * 16) * 85 / (150 * 16), 0, 85);
+    uint32_t color = rainbowColor(hue);
+    uint16_t reach = (uint32_t)pulseLevel * (LED_STRIP_PIXELS / 2) * 256 / 255;
+
+    uint8_t distance;
+    for (distance = 0; distance < LED_STRIP_PIXELS / 2; distance++) {
+        int16_t over = reach - distance * 256;
+        uint8_t pixelLevel = over <= 0 ? 0 : 255 - distance * 24;
+        if (over > 0 && over < 256) {
+            pixelLevel = (pixelLevel * over) >> 8;
+        }
 
-    setBrightness(brightness);
+        uint32_t pixel = scaleColor(color, pixelLevel);
+        setPixelRGB(LED_STRIP_PIXELS / 2 - 1 - distance, pixel);
+        setPixelRGB(LED_STRIP_PIXELS / 2 + distance, pixel);
+    }
 }
 
-void Strip::cycle() {
-    if (millis() - lastTime < FRAME_DURATION) {
-        return;
+/**
+ * Every STRIP_HISTORY_PERIOD ms the strip moves along a pixel and the first
+ * one takes the loudest band, coloured by where it is in the spectrum
+ */
+void Strip::scroll() {
+    if ((int32_t)(now - nextScroll) >= 0) {
+        nextScroll = now + STRIP_HISTORY_PERIOD;
+
+        const Visualizer::Frame &frame = visualizer->getFrame();
+        uint8_t hue = frame.maximumIndex * 170 / Visualizer::analysisBins;
+        uint8_t level = (((uint32_t)frame.maximumValue + 1) * 255) >> 15;
+        memmove(history + 1, history, sizeof(history) - sizeof(history[0]));
+        history[0] = scaleColor(rainbowColor(hue), level);
     }
 
     uint8_t index;
     for (index = 0; index < LED_STRIP_PIXELS; index++) {
-        setPixelColor(index, Wheel(position + index));
+        setPixelRGB(index, history[index]);
     }
+}
 
-    position++;
-    lastTime = millis();
+// 0xRRGGBB straight into the pixel buffer
+void Strip::setPixelRGB(uint8_t index, uint32_t color) {
+    setPixelColor(index, Color(color >> 16, color >> 8, color));
+}
+
+// Mix the saved frame into the one just rendered (blendFrame())
+void Strip::crossfade(uint8_t targetBrightness) {
+    uint32_t elapsed = now - fadeStart;
+    if (elapsed >= STRIP_CROSSFADE) {
+        fading = false;
+        setBrightness(targetBrightness);
+        return;
+    }
+
+    blendFrame(fadePixels, fadeBrightness, targetBrightness, elapsed * 256 / STRIP_CROSSFADE);
 }
@@ -1,38 +1,93 @@
 #ifndef _STRIP_H_
 #define _STRIP_H_
 
-#include <QList.h>
-#include "QList.cpp"
-#include <Adafruit_DotStar.h>
+/******************************************************************************
+
+The LED strip
+
+The strip runs one mode at a time and changes mode with the matrix: every
+matrix effect names the strip mode that goes with it (MatrixEffect.h), and
+the strip fades across with it over STRIP_CROSSFADE ms. Colours come from
+the rainbow table in flash (Palette.h) and modes draw levels through
+scaleColor(), so a pixel is a table read and a multiply.
+
+******************************************************************************/
 
 #include "AudioVisualizer.h"
+#include "DotStarOutput.h"
+#include "Matrix.h"
+#include "RingBuffer.h"
 
 #define LED_STRIP_PIXELS    16
 #define LED_STRIP_DATA_PIN  6
 #define LED_STRIP_CLOCK_PIN 5
 
-class Strip : public Adafruit_DotStar {
+#define STRIP_RAINBOW   0   // The rainbow, jumping in brightness and along on beats
+#define STRIP_METER     1   // Level as a VU meter along the strip
+#define STRIP_PULSE     2   // Bass level spreading out from the centre
+#define STRIP_HISTORY   3   // The loudest band, scrolling along the strip
+
+// Beat brightness: an onset as strong as the recent average lands midway
+// between these, and one STRIP_BEAT_SPREAD standard deviations above or below
+// it at the top or the bottom
+#define STRIP_BEAT_DIMMEST      64
+#define STRIP_BEAT_BRIGHTEST    228
+#define STRIP_BEAT_SPREAD       2
+
+// ms to fade from one mode into the next, as long as the matrix takes
+#define STRIP_CROSSFADE         400
+
+// Brightness of every mode but the rainbow, which goes by the beat
+#define STRIP_BRIGHTNESS        96
+// ms for the band history to move along one pixel
+#define STRIP_HISTORY_PERIOD    40
+
+class Strip : public DotStarOutput {
 public:
     Strip();
 
-    uint16_t colorWheel(byte position);
-    void initialize(AudioVisualizer pVisualizer);
-    void loop();
+    void initialize(const Visualizer &pVisualizer, const Matrix &pMatrix);
+    void loop(uint32_t tickTime);
 
     static uint32_t Color(uint8_t red, uint8_t green, uint8_t blue);
 
+    // Brightness for an onset of `strength` next to the recent ones, which
+    // it joins; all of calculateBeat()'s work for a new onset
+    uint8_t scoreOnset(float32_t strength);
+
 private:
-    AudioVisualizer visualizer;
+    const Visualizer *visualizer;
+    const Matrix *matrix;
+    uint32_t lastSequence;
     uint8_t brightness;
-    QList<float32_t> previousReads;
-    long lastTime;
+    uint32_t now;
     uint8_t position;
     uint8_t currentCycle;
-    float32_t largestRead;
-    long lastBeat;
+    uint32_t lastBeat;
+    uint32_t lastOnset;
+    RingBuffer<float32_t, 16> onsetStrengths;
+
+    // Current mode, and the last frame of the one before while fading
+    uint8_t mode;
+    bool fading;
+    uint32_t fadeStart;
+    uint8_t fadeBrightness;
+    uint8_t fadePixels[LED_STRIP_PIXELS * 3];
+
+    uint16_t meterLevel;    // Pixels in 8.8 fixed point
+    uint16_t meterPeak;
+    uint8_t pulseLevel;
+    uint32_t nextScroll;
+    uint32_t history[LED_STRIP_PIXELS];
 
     void calculateBeat();
+    void startMode(uint8_t index);
     void cycle();
+    void meter();
+    void pulse();
+    void scroll();
+    void setPixelRGB(uint8_t index, uint32_t color);
+    void crossfade(uint8_t targetBrightness);
 };
 
 #endif
@@ -0,0 +1,246 @@
+#include "Profile.h"
+#include "Telemetry.h"
+
+static const uint8_t telemetryRates[] = TELEMETRY_RATES;
+
+static uint16_t crc16(const uint8_t *data, uint16_t length) {
+    uint16_t crc = 0xFFFF;
+    for (uint16_t i = 0; i < length; i++) {
+        crc ^= (uint16_t)data[i] << 8;
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = crc & 0x8000 ? (crc << 1) ^ 0x1021 : crc << 1;
+        }
+    }
+
+    return crc;
+}
+
+static uint16_t scaleLevel(float32_t level) {
+    float32_t scaled = level * TELEMETRY_LEVEL_SCALE + 0.5f;
+    return scaled <= 0 ? 0 : (scaled >= 65535 ? 65535 : (uint16_t)scaled);
+}
+
+// Q15 levels, without going through floats
+static uint16_t scaleLevel(q15_t level) {
+    return level <= 0 ? 0 : ((uint32_t)level * TELEMETRY_LEVEL_SCALE + 16384) >> 15;
+}
+
+Telemetry::Telemetry() {
+    visualizer = NULL;
+    scheduler = NULL;
+    rate = TELEMETRY_RATE;
+    lastReport = 0;
+    lastSequence = 0;
+    lastOnset = 0;
+    lastBass = 0;
+    packets = 0;
+    dropped = 0;
+    queueHead = 0;
+    queueCount = 0;
+    packetLength = 0;
+}
+
+void Telemetry::initialize(const Visualizer &pVisualizer, Scheduler &pScheduler) {
+    visualizer = &pVisualizer;
+    scheduler = &pScheduler;
+    lastOnset = visualizer->getFrame().onsetTime;
+    lastReport = halMillis();
+
+    Serial.begin(115200);
+}
+
+void Telemetry::setRate(uint8_t reportsPerSecond) {
+    rate = reportsPerSecond;
+}
+
+uint8_t Telemetry::getRate() {
+    return rate;
+}
+
+uint32_t Telemetry::getPackets() {
+    return packets;
+}
+
+uint32_t Telemetry::getDropped() {
+    return dropped;
+}
+
+void Telemetry::loop(uint32_t tickTime) {
+    readCommands();
+
+    if (rate > 0) {
+        const Visualizer::Frame &frame = visualizer->getFrame();
+        if (frame.sequence != lastSequence && frame.onsetTime != lastOnset) {
+            lastOnset = frame.onsetTime;
+            sendOnset(frame);
+        }
+        lastSequence = frame.sequence;
+
+        if (tickTime - lastReport >= 1000u / rate) {
+            lastReport = tickTime;
+            sendSpectrum(frame);
+            if (frame.bassSequence != lastBass) {
+                lastBass = frame.bassSequence;
+                sendBass(frame);
+            }
+            sendTiming();
+        }
+    }
+
+    sendQueued();
+}
+
+void Telemetry::readCommands() {
+    while (Serial.available() > 0) {
+        int command = Serial.read();
+        if (command >= '0' && command < '0' + (int)sizeof(telemetryRates)) {
+            rate = telemetryRates[command - '0'];
+        }
+    }
+}
+
+/**
+ * As much of the queue as the port takes without blocking
+ */
+void Telemetry::sendQueued() {
+    while (queueCount > 0) {
+        uint16_t free = Serial.availableForWrite();
+        if (free == 0) {
+            return;
+        }
+
+        uint16_t start = (queueHead + TELEMETRY_BUFFER - queueCount) % TELEMETRY_BUFFER;
+        uint16_t length = min(queueCount, min(free, TELEMETRY_BUFFER - start));
+        length = Serial.write(queue + start, length);
+        if (length == 0) {
+            return;
+        }
+        queueCount -= length;
+    }
+}
+
+void Telemetry::beginPacket(uint8_t type) {
+    packetLength = 0;
+    put8(type);
+}
+
+void Telemetry::put8(uint8_t value) {
+    if (packetLength < TELEMETRY_PACKET - 2) {
+        packet[packetLength++] = value;
+    }
+}
+
+void Telemetry::put16(uint16_t value) {
+    put8((uint8_t)value);
+    put8((uint8_t)(value >> 8));
+}
+
+void Telemetry::put32(uint32_t value) {
+    put16((uint16_t)value);
+    put16((uint16_t)(value >> 16));
+}
+
+/**
+ * Add the CRC and queue the packet COBS encoded, or drop it if it does not fit
+ */
+void Telemetry::endPacket() {
+    uint16_t crc = crc16(packet, packetLength);
+    packet[packetLength++] = (uint8_t)crc;
+    packet[packetLength++] = (uint8_t)(crc >> 8);
+
+    // One code byte per 254 data bytes, plus the delimiter
+    uint16_t encodedLength = packetLength + packetLength / 254 + 2;
+    if (TELEMETRY_BUFFER - queueCount < encodedLength) {
+        dropped++;
+        return;
+    }
+
+    uint16_t start = queueHead;
+    uint16_t code = queueHead;
+    uint8_t run = 1;
+    queueHead = (queueHead + 1) % TELEMETRY_BUFFER;
+    for (uint16_t i = 0; i < packetLength; i++) {
+        if (packet[i] != 0) {
+            queue[queueHead] = packet[i];
+            queueHead = (queueHead + 1) % TELEMETRY_BUFFER;
+            run++;
+        }
+
+        if (packet[i] == 0 || run == 0xFF) {
+            queue[code] = run;
+            code = queueHead;
+            run = 1;
+            queueHead = (queueHead + 1) % TELEMETRY_BUFFER;
+        }
+    }
+    queue[code] = run;
+    queue[queueHead] = 0;
+    queueHead = (queueHead + 1) % TELEMETRY_BUFFER;
+
+    queueCount += (queueHead + TELEMETRY_BUFFER - start) % TELEMETRY_BUFFER;
+    packets++;
+}
+
+void Telemetry::sendSpectrum(const Visualizer::Frame &frame) {
+    beginPacket(TELEMETRY_SPECTRUM);
+    put32(frame.sequence);
+    put32(frame.time);
+    put8(Visualizer::analysisBins);
+    for (uint8_t i = 0; i < Visualizer::analysisBins; i++) {
+        put16(scaleLevel(frame.smoothed[i]));
+    }
+    endPacket();
+}
+
+void Telemetry::sendOnset(const Visualizer::Frame &frame) {
+    beginPacket(TELEMETRY_ONSET);
+    put32(frame.onsetTime);
+    put16(scaleLevel(frame.onsetStrength));
+    put8(frame.onsetBands);
+    endPacket();
+}
+
+void Telemetry::sendBass(const Visualizer::Frame &frame) {
+    beginPacket(TELEMETRY_BASS);
+    put32(frame.bassSequence);
+    put32(frame.bassTime);
+    put16(frame.bassPeakFrequency);
+    put16(scaleLevel(frame.bassPeakValue));
+    put16((uint16_t)(256.0f * Visualizer::bassRate / BASS_FFT_SAMPLES + 0.5f));
+    put8(Visualizer::bassBins);
+    for (uint8_t i = 0; i < Visualizer::bassBins; i++) {
+        put16(scaleLevel(frame.bass[i]));
+    }
+    endPacket();
+}
+
+void Telemetry::sendTiming() {
+    beginPacket(TELEMETRY_TIMING);
+    put32(halMicros());
+    put32(halSampleOverruns());
+    put32(dropped);
+    put32(scheduler->getElapsedTime());
+    put32(scheduler->getBusyTime());
+    put32(scheduler->getIdleTime());
+
+    put8(scheduler->getTaskCount());
+    for (uint8_t i = 0; i < scheduler->getTaskCount(); i++) {
+        const SchedulerStats &task = scheduler->getStats(i);
+        put32(task.runs);
+        put32(task.totalTime);
+        put32(task.worstTime);
+        put32(task.totalLateness);
+        put32(task.worstLateness);
+        put32(task.missed);
+        put32(task.dropped);
+    }
+
+    put8(PROFILE_STAGES);
+    for (uint8_t i = 0; i < PROFILE_STAGES; i++) {
+        const ProfileStage &stage = profileStage(i);
+        put32(stage.count);
+        put32((uint32_t)stage.totalCycles);
+        put32(stage.worstCycles);
+    }
+    endPacket();
+}
@@ -0,0 +1,114 @@
+#ifndef _TELEMETRY_H_
+#define _TELEMETRY_H_
+
+/******************************************************************************
+
+Binary telemetry over the USB serial port
+
+Packets are queued in a TELEMETRY_BUFFER byte ring and loop() hands the serial
+port only as much as it can take without blocking. When the ring is full a
+packet is dropped whole and counted, so the decoder never sees half of one.
+
+On the wire every packet is COBS encoded and ends with a 0x00, so a reader can
+start anywhere and resynchronise on the next zero. Decoded, a packet is
+
+    uint8   type
+    ...     payload, little endian
+    uint16  CRC-16/CCITT (0x1021, initial 0xFFFF) of type and payload
+
+    TELEMETRY_SPECTRUM  uint32 sequence, uint32 time (us), uint8 bins,
+                        bins * uint16 smoothed level (0..1) * TELEMETRY_LEVEL_SCALE
+    TELEMETRY_ONSET     uint32 time (us), uint16 strength * TELEMETRY_LEVEL_SCALE,
+                        uint8 bands
+    TELEMETRY_BASS      uint32 bass sequence, uint32 time (us), uint16 peak
+                        frequency * 16 (Hz), uint16 peak level * TELEMETRY_LEVEL_SCALE,
+                        uint16 bin width * 256 (Hz), uint8 bins, bins * uint16
+                        level * TELEMETRY_LEVEL_SCALE
+    TELEMETRY_TIMING    uint32 time (us), uint32 capture overruns,
+                        uint32 dropped packets, uint32 elapsed, busy and
+                        idle time (Scheduler.h), uint8 tasks, then per task
+                        uint32 runs, total time, worst time, total lateness,
+                        worst lateness, missed, dropped; uint8 stages, then
+                        per stage (Profile.h) uint32 count, total cycles,
+                        worst cycles. Task times in us, stage times in CPU
+                        cycles (HAL_CPU_CLOCK), all counters since boot and
+                        totals wrapping round at 2^32.
+
+Spectrum, bass and timing go out at the report rate (bass only when there
+is a new bass frame), onsets as they happen while the rate is not 0. The rate starts at TELEMETRY_RATE and can be changed from
+the host by sending one ASCII digit, an index into TELEMETRY_RATES
+(host/tools/telemetry.py --rate).
+
+******************************************************************************/
+
+#include <Arduino.h>
+
+#include "AudioVisualizer.h"
+#include "Profile.h"
+#include "Scheduler.h"
+
+#define TELEMETRY_BUFFER        768
+// Largest decoded packet: a spectrum of every analysis or bass bin, or timing
+// from every task and stage
+#define TELEMETRY_SPECTRUM_SIZE (12 + 2 * Visualizer::analysisBins)
+#define TELEMETRY_BASS_SIZE     (18 + 2 * Visualizer::bassBins)
+#define TELEMETRY_TIMING_SIZE   (29 + 28 * SCHEDULER_TASKS + 12 * PROFILE_STAGES)
+#define TELEMETRY_LARGEST       (TELEMETRY_SPECTRUM_SIZE > TELEMETRY_BASS_SIZE ? TELEMETRY_SPECTRUM_SIZE : TELEMETRY_BASS_SIZE)
+#define TELEMETRY_PACKET        (TELEMETRY_LARGEST > TELEMETRY_TIMING_SIZE ? TELEMETRY_LARGEST : TELEMETRY_TIMING_SIZE)
+
+#define TELEMETRY_SPECTRUM      1
+#define TELEMETRY_ONSET         2
+#define TELEMETRY_TIMING        3
+#define TELEMETRY_BASS          4
+
+#define TELEMETRY_LEVEL_SCALE   256
+
+// Reports per second selected by the digits '0'..'9'
+#define TELEMETRY_RATES         { 0, 1, 2, 5, 10, 20, 25, 50, 100, 125 }
+
+class Telemetry {
+public:
+    Telemetry();
+
+    void initialize(const Visualizer &pVisualizer, Scheduler &pScheduler);
+    void loop(uint32_t tickTime);
+    void setRate(uint8_t reportsPerSecond);
+
+    uint8_t getRate();
+    uint32_t getPackets();
+    uint32_t getDropped();
+
+private:
+    const Visualizer *visualizer;
+    Scheduler *scheduler;
+    uint8_t rate;
+    uint32_t lastReport;
+    uint32_t lastSequence;
+    uint32_t lastOnset;
+    uint32_t lastBass;
+    uint32_t packets;
+    uint32_t dropped;
+
+    uint8_t queue[TELEMETRY_BUFFER];
+    uint16_t queueHead;
+    uint16_t queueCount;
+
+    uint8_t packet[TELEMETRY_PACKET];
+    uint16_t packetLength;
+
+    void readCommands();
+    void sendQueued();
+
+    void beginPacket(uint8_t type);
+    void put8(uint8_t value);
+    void put16(uint16_t value);
+    void put32(uint32_t value);
+    void endPacket();
+
+    void sendSpectrum(const Visualizer::Frame &frame);
+    void sendOnset(const Visualizer::Frame &frame);
+    void sendBass(const Visualizer::Frame &frame);
+    void sendTiming();
+};
+
+#endif
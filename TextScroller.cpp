@@ -0,0 +1,77 @@
+#include "TextScroller.h"
+
+// A quarter of a column a frame
+#define TEXT_DEFAULT_SPEED  64
+
+TextScroller::TextScroller()
+    : Adafruit_GFX(TEXT_MAX_COLUMNS, TEXT_HEIGHT)
+{
+    length = 0;
+    position = 0;
+    speed = TEXT_DEFAULT_SPEED;
+    memset(columns, 0, sizeof(columns));
+}
+
+void TextScroller::beginMessage() {
+    memset(columns, 0, sizeof(columns));
+    setTextWrap(false);
+    setTextColor(1);
+    setCursor(0, 0);
+}
+
+// Anything past TEXT_MAX_COLUMNS was clipped by the rasteriser
+void TextScroller::endMessage() {
+    length = min(getCursorX(), TEXT_MAX_COLUMNS);
+    restart();
+}
+
+void TextScroller::setMessage(const char *message) {
+    beginMessage();
+    print(message);
+    endMessage();
+}
+
+void TextScroller::setMessage(const __FlashStringHelper *message) {
+    beginMessage();
+    print(message);
+    endMessage();
+}
+
+void TextScroller::setSpeed(uint16_t columnsPerFrame) {
+    speed = columnsPerFrame;
+}
+
+// Start with the first character at the left edge
+void TextScroller::restart() {
+    position = 0;
+}
+
+/**
+ * Pixels of screen column `x` at the current position, bit 0 at the top
+ */
+uint8_t TextScroller::column(int16_t x) {
+    int16_t c = (position >> 8) + x;
+    return c >= 0 && c < length ? columns[c] : 0;
+}
+
+void TextScroller::advance(int16_t viewWidth) {
+    position += speed;
+    if ((position >> 8) > length) {
+        position = -((int32_t)viewWidth << 8);
+    }
+}
+
+uint8_t TextScroller::getLength() {
+    return length;
+}
+
+// Only called while rasterising a message
+void TextScroller::drawPixel(int16_t x, int16_t y, uint16_t color) {
+    if ((x < 0 || y < 0) || (x >= TEXT_MAX_COLUMNS || y >= TEXT_HEIGHT)) return;
+
+    if (color) {
+        columns[x] |= 1 << y;
+    } else {
+        columns[x] &= ~(1 << y);
+    }
+}
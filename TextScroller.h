@@ -0,0 +1,51 @@
+#ifndef _TEXT_SCROLLER_H_
+#define _TEXT_SCROLLER_H_
+
+/******************************************************************************
+
+Scrolling text, rasterised once
+
+setMessage() prints the message through Adafruit_GFX a single time into a
+1 bit per pixel bitmap of one byte per column, bit 0 at the top. Every frame
+after that is a window onto the bitmap at the current scroll position, so
+drawing is a byte per screen column instead of the glyph rasteriser and a
+drawPixel() call per lit pixel.
+
+The position and speed are 8.8 fixed point columns, so the text can move by
+less than a column a frame. Once the message has scrolled off the left edge it
+comes back in from the right.
+
+******************************************************************************/
+
+#include <Adafruit_GFX.h>
+
+// Room for 32 characters of the 6 pixel wide built-in font
+#define TEXT_MAX_COLUMNS    192
+#define TEXT_HEIGHT         8
+
+class TextScroller : public Adafruit_GFX {
+public:
+    TextScroller();
+
+    void setMessage(const char *message);
+    void setMessage(const __FlashStringHelper *message);
+    void setSpeed(uint16_t columnsPerFrame);
+    void restart();
+
+    uint8_t column(int16_t x);
+    void advance(int16_t viewWidth);
+
+    uint8_t getLength();
+    void drawPixel(int16_t x, int16_t y, uint16_t color);
+
+private:
+    uint8_t columns[TEXT_MAX_COLUMNS];
+    uint8_t length;
+    int32_t position;
+    uint16_t speed;
+
+    void beginMessage();
+    void endMessage();
+};
+
+#endif
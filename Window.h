@@ -0,0 +1,70 @@
+#ifndef _WINDOW_H_
+#define _WINDOW_H_
+
+/******************************************************************************
+
+Analysis windows, generated by the compiler
+
+makeWindow<T, N>() evaluates the window with constexpr maths, so a table
+declared with it is a plain constant in flash and follows the FFT size without
+anybody typing numbers in. The Arduino SAMD core builds with -std=gnu++11, so
+everything here sticks to single-return C++11 constexpr functions.
+
+******************************************************************************/
+
+#define WINDOW_RECTANGULAR  0
+#define WINDOW_HANN         1
+#define WINDOW_BLACKMAN     2
+
+#define WINDOW_PI           3.14159265358979323846
+
+// cos(x) for 0 <= x, by reduction into [-pi, pi] and a Taylor series
+constexpr double windowReduce(double x) {
+    return x > WINDOW_PI ? windowReduce(x - 2 * WINDOW_PI) : x;
+}
+
+constexpr double windowCosSeries(double x2, double term, int n, double sum) {
+    return n > 24 ? sum : windowCosSeries(x2, -term * x2 / ((2 * n - 1) * (2 * n)), n + 1,
+                                          sum - term * x2 / ((2 * n - 1) * (2 * n)));
+}
+
+constexpr double windowCos(double x) {
+    return windowCosSeries(windowReduce(x) * windowReduce(x), 1.0, 1, 1.0);
+}
+
+// Periodic windows (denominator N), which overlap-add cleanly at 50% and 75%
+constexpr double windowShape(int type, int i, int n) {
+    return type == WINDOW_HANN ? 0.5 - 0.5 * windowCos(2 * WINDOW_PI * i / n) :
+           type == WINDOW_BLACKMAN ? 0.42 - 0.5 * windowCos(2 * WINDOW_PI * i / n) + 0.08 * windowCos(4 * WINDOW_PI * i / n) :
+           1.0;
+}
+
+// Coherent gain: how much the window scales the magnitude of a steady tone
+constexpr double windowGain(int type) {
+    return type == WINDOW_HANN ? 0.5 : type == WINDOW_BLACKMAN ? 0.42 : 1.0;
+}
+
+template<int... I> struct WindowIndices {};
+template<int N, int... I> struct MakeWindowIndices : MakeWindowIndices<N - 1, N - 1, I...> {};
+template<int... I> struct MakeWindowIndices<0, I...> { typedef WindowIndices<I...> type; };
+
+template<typename T, int N>
+struct WindowTable {
+    T values[N];
+};
+
+template<typename T, int N, int... I>
+constexpr WindowTable<T, N> makeWindowTable(int type, double scale, bool round, WindowIndices<I...>) {
+    return {{ (T)(windowShape(type, I, N) * scale + (round ? 0.5 : 0.0))... }};
+}
+
+/**
+ * N coefficients of window `type`, each multiplied by `scale` and, for
+ * integer tables, rounded to nearest
+ */
+template<typename T, int N>
+constexpr WindowTable<T, N> makeWindow(int type, double scale, bool round) {
+    return makeWindowTable<T, N>(type, scale, round, typename MakeWindowIndices<N>::type());
+}
+
+#endif
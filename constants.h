@@ -2,6 +2,61 @@
 #define _CONSTANTS_H_
 
 // Global Application Defines
+
+// The analysis this build runs, AudioVisualizer<FFT_SAMPLES, SAMPLE_RATE>: a
+// power of two from 32 to 256 points. 64 gives 225Hz bins and a frame every
+// 2.2ms, 256 gives 56Hz bins and a frame every 8.9ms (with STFT_OVERLAP 2).
 #define FFT_SAMPLES     64
+// Fixed by the ADC set up in HalSamd.cpp
+#define SAMPLE_RATE     14400
+
+// Run the analysis in Q15 fixed point instead of software emulated floats.
+// Comment out to go back to the float32_t pipeline.
+#define FIXED_POINT_ANALYSIS
+
+// Instead of a full FFT per block, update only bins 0..SLIDING_DFT_BINS - 1
+// with a sliding DFT on every sample and publish them every SLIDING_DFT_HOP
+// samples. Needs FIXED_POINT_ANALYSIS. The hop is the block size, so it has to
+// outlast the bit-banged display frames (goggles.ino).
+//#define SLIDING_DFT_ANALYSIS
+#define SLIDING_DFT_BINS    16
+#define SLIDING_DFT_HOP     32
+
+// FFT frames overlap: a new frame every FFT_SAMPLES / STFT_OVERLAP samples
+// (1 = none, 2 = 50%, 4 = 75%), windowed with STFT_WINDOW (see Window.h).
+// That is the sample block, which has to outlast the bit-banged display
+// frames (1.6ms, goggles.ino checks), so at least 32 samples: 4 needs 128
+// points or more, 2 needs 64, and 32 points take 1. Not used by the sliding
+// DFT.
+#define STFT_OVERLAP    2
+#define STFT_WINDOW     WINDOW_HANN
+
+// Samples per captured block, i.e. how often there is something to analyse
+#ifdef SLIDING_DFT_ANALYSIS
+#define SAMPLE_BLOCK    SLIDING_DFT_HOP
+#else
+#define SAMPLE_BLOCK    (FFT_SAMPLES / STFT_OVERLAP)
+#endif
+
+// Bass branch: the captured stream, low pass filtered and decimated by
+// BASS_DECIMATION, goes into its own BASS_FFT_SAMPLES point Q15 FFT every
+// BASS_HOP decimated samples. At 14.4kHz that is 1800Hz, 7Hz bins up to
+// 900Hz and 28 frames a second.
+#define BASS_DECIMATION     8
+#define BASS_FFT_SAMPLES    256
+#define BASS_HOP            64
+
+// Display columns are spread over the analysis bins on this frequency scale
+// (see Filterbank.h)
+#define COLUMN_SCALE    FREQUENCY_SCALE_MEL
+
+// Telemetry reports per second at boot, 0 for none until the host asks for
+// them (see Telemetry.h)
+#define TELEMETRY_RATE  0
+
+// Microphone has DC bias of 1.25V and 2Vpp. VCC is 3.3V, reading is 12b (so 0-4095)
+#define MICROPHONE_LOW          310
+#define MICROPHONE_MIDPOINT     1551
+#define MICROPHONE_HIGH         2793
 
 #endif
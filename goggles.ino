@@ -13,7 +13,6 @@ Hardware:
 Software Libraries:
     - Adafruit_DotStar (https://github.com/adafruit/Adafruit_DotStar)
     - Adafruit-GFX-Library (https://github.com/adafruit/Adafruit-GFX-Library)
-    - QList (https://github.com/SloCompTech/QList)
 
 ******************************************************************************/
 
@@ -22,22 +21,64 @@ Software Libraries:
 
 #include "AudioVisualizer.h"
 #include "Matrix.h"
+#include "Scheduler.h"
 #include "Strip.h"
+#include "Telemetry.h"
 #include "graphics.h"
 
-AudioVisualizer visualizer = AudioVisualizer();
+// Periods and deadlines in us. Analysis polls on every tick and has to be done
+// before the next block lands; the displays run at a steady 125 frames/s.
+#define ANALYSIS_DEADLINE   ((uint32_t)SAMPLE_BLOCK * 1000000 / SAMPLE_RATE)
+#define MATRIX_PERIOD       8000
+#define STRIP_PERIOD        8000
+#define TELEMETRY_PERIOD    8000
+
+// Bit-banged display frames hold up the loop (Hal.h), both back to back at
+// worst. One block may complete meanwhile, a second drops the first, so the
+// frames have to go out within a block: that bounds SAMPLE_BLOCK, and with it
+// STFT_OVERLAP and SLIDING_DFT_HOP.
+#define DISPLAY_BLOCKING_BITS \
+    (8 * (DOTSTAR_FRAME_BYTES(MATRIX_SIZE * 2 * MATRIX_SIZE) + DOTSTAR_FRAME_BYTES(LED_STRIP_PIXELS)))
+static_assert((uint64_t)DISPLAY_BLOCKING_BITS * SAMPLE_RATE < (uint64_t)SAMPLE_BLOCK * PIXEL_BITBANG_CLOCK,
+              "Sample blocks are shorter than the bit-banged display frames, blocks would be dropped");
+
+Visualizer visualizer = Visualizer();
 Matrix matrix = Matrix();
 Strip strip = Strip();
+Scheduler scheduler = Scheduler();
+Telemetry telemetry = Telemetry();
+
+bool runVisualizer(uint32_t now) {
+    return visualizer.loop();
+}
+
+bool runMatrix(uint32_t now) {
+    matrix.loop(now);
+    return true;
+}
+
+bool runStrip(uint32_t now) {
+    strip.loop(now);
+    return true;
+}
+
+bool runTelemetry(uint32_t now) {
+    telemetry.loop(now);
+    return true;
+}
 
 void setup() {
-    //Serial.begin(115200);
     visualizer.initialize();
     matrix.initialize(visualizer);
-    strip.initialize(visualizer);
+    strip.initialize(visualizer, matrix);
+    telemetry.initialize(visualizer, scheduler);
+
+    scheduler.add("analysis", runVisualizer, 0, ANALYSIS_DEADLINE);
+    scheduler.add("matrix", runMatrix, MATRIX_PERIOD, MATRIX_PERIOD);
+    scheduler.add("strip", runStrip, STRIP_PERIOD, STRIP_PERIOD);
+    scheduler.add("telemetry", runTelemetry, TELEMETRY_PERIOD, TELEMETRY_PERIOD);
 }
 
 void loop() {
-    visualizer.loop();
-    matrix.loop();
-    strip.loop();
+    scheduler.loop();
 }
@@ -1,195 +1,147 @@
-// http://www.digole.com/tools/PicturetoC_Hex_converter.php
+// Generated by host/tools/sprites.py from bitmaps/*.png, do not edit
+// 1143 bytes of sprite data for 3456 bytes of pixels
 
 #ifndef _GFX_H_
 #define _GFX_H_
 
-static const uint8_t PROGMEM HEART[] = { 0x66, 0xFF, 0xFF, 0xFF, 0x7E, 0x3C, 0x18, 0x00 };
-
-static const uint8_t PROGMEM BEER[] = {
-    0x00,0x00,0x00,0xe4,0xe4,0xe4,0xe4,0xe4,0xe4,0xe4,0xe4,0xe4,0xe4,0xe4,0xe4,0xe4,0xe4,0xe4,0x00,0x00,0x00,0x00,0x00,0x00,
-    0xe4,0xe4,0xe4,0xe4,0xe4,0xe4,0xe4,0xe4,0xe4,0xe4,0xe4,0xe4,0xe4,0xe4,0xe4,0xe8,0xd0,0x58,0xe4,0xe4,0xe4,0x00,0x00,0x00,
-    0xe4,0xe4,0xe4,0xe8,0xd0,0x58,0xe4,0xe4,0xe4,0xe4,0xe4,0xe4,0xe4,0xe4,0xe4,0xd4,0xb8,0x3c,0xd4,0xb8,0x3c,0x00,0x00,0x00,
-    0xe4,0xe4,0xe4,0xd4,0xb8,0x3c,0xe8,0xec,0x58,0xe4,0xe4,0xe4,0xd4,0xb8,0x3c,0xd4,0xb8,0x3c,0xc0,0xc0,0xc0,0xc0,0xc0,0xc0,
-    0x00,0x00,0x00,0xd4,0xc8,0xa4,0xd4,0xb8,0x3c,0xd4,0xb8,0x3c,0xd4,0xd0,0x3c,0xd4,0xd0,0x3c,0x00,0x00,0x00,0xc0,0xc0,0xc0,
-    0x00,0x00,0x00,0xd4,0xc8,0xa4,0xd4,0xd0,0x3c,0xd4,0xd0,0x3c,0xd4,0xd0,0x3c,0xd4,0xd0,0x3c,0x00,0x00,0x00,0xc0,0xc0,0xc0,
-    0x00,0x00,0x00,0xd4,0xd0,0x3c,0xd4,0xd0,0x3c,0xd4,0xd0,0x3c,0xd4,0xd0,0x3c,0xd4,0xd0,0x3c,0xc0,0xc0,0xc0,0x00,0x00,0x00,
-    0x00,0x00,0x00,0x98,0x60,0x0c,0xd8,0xa4,0x20,0xd8,0xa4,0x20,0xd8,0xa4,0x20,0x98,0x60,0x0c,0x00,0x00,0x00,0x00,0x00,0x00
-};
-
-static const uint8_t PROGMEM CHERRIES[] = {
-    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x90,0x30,0x00,0x90,0x30,0x00,0x90,0x30,0x00,0x00,0x00,
-    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x90,0x30,0x00,0x00,0x00,0x00,0x90,0x30,0x00,0x00,0x00,0x00,0x00,0x00,
-    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x90,0x30,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x90,0x30,0x00,0x00,0x00,0x00,0x00,0x00,
-    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x90,0x30,0x00,0x00,0x00,0x00,0x00,0x00,0xe8,0x00,0x00,0xe8,0x00,0x00,0x00,0x00,0x00,
-    0x00,0x00,0x00,0xe8,0x00,0x00,0xe8,0x00,0x00,0x00,0x00,0x00,0xe8,0x00,0x00,0xe8,0x00,0x00,0xfc,0xfc,0xfc,0xe8,0x00,0x00,
-    0xe8,0x00,0x00,0xe8,0x00,0x00,0xfc,0xfc,0xfc,0xe8,0x00,0x00,0x00,0x00,0x00,0xe8,0x00,0x00,0xe8,0x00,0x00,0xe8,0x00,0x00,
-    0xe8,0x00,0x00,0xe8,0x00,0x00,0xe8,0x00,0x00,0xe8,0x00,0x00,0x00,0x00,0x00,0xe8,0x00,0x00,0xe8,0x00,0x00,0x00,0x00,0x00,
-    0x00,0x00,0x00,0xe8,0x00,0x00,0xe8,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00
-};
-
-static const uint8_t PROGMEM EYE_CENTER[] = {
-    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-    0x00,0x00,0x00,0x00,0x00,0x00,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0x00,0x00,0x00,0x00,0x00,0x00,
-    0x00,0x00,0x00,0xd4,0xd4,0xd4,0xa0,0xcc,0xfc,0x00,0x28,0x54,0x00,0x28,0x54,0xa0,0xcc,0xfc,0xd4,0xd4,0xd4,0x00,0x00,0x00,
-    0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0x00,0x28,0x54,0x00,0x78,0xfc,0x00,0x78,0xfc,0x00,0x28,0x54,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,
-    0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0x00,0x28,0x54,0x00,0x78,0xfc,0x00,0x78,0xfc,0x00,0x28,0x54,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,
-    0x00,0x00,0x00,0xd4,0xd4,0xd4,0xa0,0xcc,0xfc,0x00,0x28,0x54,0x00,0x28,0x54,0xa0,0xcc,0xfc,0xd4,0xd4,0xd4,0x00,0x00,0x00,
-    0x00,0x00,0x00,0x00,0x00,0x00,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0x00,0x00,0x00,0x00,0x00,0x00,
-    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00
-};
-
-static const uint8_t PROGMEM EYE_LEFT[] = {
-    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-    0x00,0x00,0x00,0x00,0x00,0x00,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0x00,0x00,0x00,0x00,0x00,0x00,
-    0x00,0x00,0x00,0xa0,0xcc,0xfc,0x00,0x28,0x54,0x00,0x28,0x54,0xa0,0xcc,0xfc,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0x00,0x00,0x00,
-    0xd4,0xd4,0xd4,0x00,0x28,0x54,0x00,0x78,0xfc,0x00,0x78,0xfc,0x00,0x28,0x54,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,
-    0xd4,0xd4,0xd4,0x00,0x28,0x54,0x00,0x78,0xfc,0x00,0x78,0xfc,0x00,0x28,0x54,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,
-    0x00,0x00,0x00,0xa0,0xcc,0xfc,0x00,0x28,0x54,0x00,0x28,0x54,0xa0,0xcc,0xfc,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0x00,0x00,0x00,
-    0x00,0x00,0x00,0x00,0x00,0x00,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0x00,0x00,0x00,0x00,0x00,0x00,
-    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00
-};
-
-static const uint8_t PROGMEM EYE_RIGHT[] = {
-    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-    0x00,0x00,0x00,0x00,0x00,0x00,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0x00,0x00,0x00,0x00,0x00,0x00,
-    0x00,0x00,0x00,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xa0,0xcc,0xfc,0x00,0x28,0x54,0x00,0x28,0x54,0xa0,0xcc,0xfc,0x00,0x00,0x00,
-    0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0x00,0x28,0x54,0x00,0x78,0xfc,0x00,0x78,0xfc,0x00,0x28,0x54,0xd4,0xd4,0xd4,
-    0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0x00,0x28,0x54,0x00,0x78,0xfc,0x00,0x78,0xfc,0x00,0x28,0x54,0xd4,0xd4,0xd4,
-    0x00,0x00,0x00,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xa0,0xcc,0xfc,0x00,0x28,0x54,0x00,0x28,0x54,0xa0,0xcc,0xfc,0x00,0x00,0x00,
-    0x00,0x00,0x00,0x00,0x00,0x00,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0x00,0x00,0x00,0x00,0x00,0x00,
-    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00
-};
-
-static const uint8_t PROGMEM EYE_UP[] = {
-    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-    0x00,0x00,0x00,0x00,0x00,0x00,0xa0,0xcc,0xfc,0x00,0x28,0x54,0x00,0x28,0x54,0xa0,0xcc,0xfc,0x00,0x00,0x00,0x00,0x00,0x00,
-    0x00,0x00,0x00,0xd4,0xd4,0xd4,0x00,0x28,0x54,0x00,0x78,0xfc,0x00,0x78,0xfc,0x00,0x28,0x54,0xd4,0xd4,0xd4,0x00,0x00,0x00,
-    0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0x00,0x28,0x54,0x00,0x78,0xfc,0x00,0x78,0xfc,0x00,0x28,0x54,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,
-    0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xa0,0xcc,0xfc,0x00,0x28,0x54,0x00,0x28,0x54,0xa0,0xcc,0xfc,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,
-    0x00,0x00,0x00,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0x00,0x00,0x00,
-    0x00,0x00,0x00,0x00,0x00,0x00,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0x00,0x00,0x00,0x00,0x00,0x00,
-    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00
-};
-
-static const uint8_t PROGMEM EYE_DOWN[] = {
-    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-    0x00,0x00,0x00,0x00,0x00,0x00,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0x00,0x00,0x00,0x00,0x00,0x00,
-    0x00,0x00,0x00,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0x00,0x00,0x00,
-    0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xa0,0xcc,0xfc,0x00,0x28,0x54,0x00,0x28,0x54,0xa0,0xcc,0xfc,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,
-    0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0x00,0x28,0x54,0x00,0x78,0xfc,0x00,0x78,0xfc,0x00,0x28,0x54,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,
-    0x00,0x00,0x00,0xd4,0xd4,0xd4,0x00,0x28,0x54,0x00,0x78,0xfc,0x00,0x78,0xfc,0x00,0x28,0x54,0xd4,0xd4,0xd4,0x00,0x00,0x00,
-    0x00,0x00,0x00,0x00,0x00,0x00,0xa0,0xcc,0xfc,0x00,0x28,0x54,0x00,0x28,0x54,0xa0,0xcc,0xfc,0x00,0x00,0x00,0x00,0x00,0x00,
-    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00
-};
-
-static const uint8_t PROGMEM EYE_BLINK[] = {
-    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-    0xd4,0xd4,0xd4,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xd4,0xd4,0xd4,
-    0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0x00,0x00,0x00,0x00,0x00,0x00,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,
-    0x00,0x00,0x00,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0xd4,0x00,0x00,0x00,
-    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00
-};
-
-static const uint8_t PROGMEM MARIO[] = {
-    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xf0,0x00,0x00,0xf0,0x00,0x00,0xf0,0x00,0x00,0xfc,0xfc,0xfc,0x00,0x00,0x00,
-    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xf0,0x00,0x00,0xf0,0x00,0x00,0xf0,0x00,0x00,0xf0,0x00,0x00,0xf0,0x00,0x00,
-    0x00,0x00,0x00,0x00,0x00,0x00,0x74,0x4c,0x00,0xcc,0xc0,0xa0,0x74,0x4c,0x00,0x00,0x00,0x00,0xcc,0xc0,0xa0,0x00,0x00,0x00,
-    0x00,0x00,0x00,0x00,0x00,0x00,0x74,0x4c,0x00,0xcc,0xc0,0xa0,0xcc,0xc0,0xa0,0x9c,0x40,0x00,0x9c,0x40,0x00,0xcc,0xc0,0xa0,
-    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xcc,0xc0,0xa0,0xcc,0xc0,0xa0,0xcc,0xc0,0xa0,0x00,0x00,0x00,
-    0x00,0x00,0x00,0xf0,0x00,0x00,0xf0,0x00,0x00,0xf0,0xd8,0x14,0x18,0xd0,0xe0,0x18,0xd0,0xe0,0xf0,0xd8,0x14,0x00,0x00,0x00,
-    0xfc,0xfc,0xfc,0x00,0x00,0x00,0x00,0x00,0x00,0x18,0xd0,0xe0,0x18,0xd0,0xe0,0x18,0xd0,0xe0,0x00,0x00,0x00,0xac,0xac,0xac,
-    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x6c,0x2c,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x6c,0x2c,0x00,0x00,0x00,0x00
-};
-
-static const uint8_t PROGMEM COLOR_SWIRL_1_LEFT[] = {
-    0xb8,0x24,0x60,0x98,0x04,0x3c,0x50,0x08,0xb0,0x50,0x08,0xb0,0x88,0x00,0x58,0x9c,0x14,0x70,0xc4,0x74,0x00,0xfc,0xb4,0x34
-    ,0x30,0x18,0xb0,0x40,0x28,0xc0,0x00,0x7c,0xfc,0x00,0x88,0xfc,0x38,0x40,0xe0,0x18,0x20,0xc0,0xac,0x24,0x00,0xfc,0x74,0x4c
-    ,0x00,0x54,0xc0,0x34,0x98,0xfc,0x48,0xf4,0xa0,0x50,0xfc,0xac,0x44,0xb4,0xfc,0x00,0x68,0xb8,0x88,0x08,0x2c,0xd0,0x50,0x70
-    ,0x0c,0x94,0xa0,0x58,0xe0,0xec,0xd4,0xd4,0x20,0xc0,0xc0,0x0c,0x74,0xd8,0xf4,0x18,0x7c,0x98,0x78,0x08,0x3c,0xb8,0x48,0x7c
-    ,0x34,0xac,0x80,0x78,0xf0,0xc4,0xe4,0x88,0x54,0x90,0x34,0x00,0x38,0x64,0xfc,0x14,0x3c,0xd8,0x90,0x10,0x18,0xdc,0x5c,0x64
-    ,0x30,0xac,0x80,0x74,0xf0,0xc8,0xf8,0x88,0x4c,0xa4,0x30,0x00,0x80,0x00,0x7c,0x88,0x00,0x80,0xbc,0x48,0x00,0xfc,0x90,0x3c
-    ,0x04,0x90,0xa0,0x54,0xe0,0xf0,0xf4,0xc8,0x30,0xc4,0x98,0x04,0xf4,0x48,0x00,0xfc,0x54,0x04,0xc0,0xb4,0x18,0xe4,0xd4,0x3c
-    ,0x00,0x54,0xc0,0x34,0x98,0xfc,0x7c,0xec,0x70,0x88,0xf8,0x78,0xcc,0xd8,0x24,0xd0,0xdc,0x24,0x7c,0xf8,0x94,0x64,0xe4,0x80
-};
-
-static const uint8_t PROGMEM COLOR_SWIRL_1_RIGHT[] = {
-    0xfc,0xb4,0x34,0xc4,0x74,0x00,0x9c,0x14,0x70,0x88,0x00,0x58,0x50,0x08,0xb0,0x50,0x08,0xb0,0x98,0x04,0x3c,0xb8,0x24,0x60
-    ,0xfc,0x74,0x4c,0xac,0x24,0x00,0x18,0x20,0xc0,0x38,0x40,0xe0,0x00,0x88,0xfc,0x00,0x7c,0xfc,0x40,0x28,0xc0,0x30,0x18,0xb0
-    ,0xd0,0x50,0x70,0x88,0x08,0x2c,0x00,0x68,0xb8,0x44,0xb4,0xfc,0x50,0xfc,0xac,0x48,0xf4,0xa0,0x34,0x98,0xfc,0x00,0x54,0xc0
-    ,0xb8,0x48,0x7c,0x78,0x08,0x3c,0x18,0x7c,0x98,0x74,0xd8,0xf4,0xc0,0xc0,0x0c,0xd4,0xd4,0x20,0x58,0xe0,0xec,0x0c,0x94,0xa0
-    ,0xdc,0x5c,0x64,0x90,0x10,0x18,0x14,0x3c,0xd8,0x38,0x64,0xfc,0x90,0x34,0x00,0xe4,0x88,0x54,0x78,0xf0,0xc4,0x34,0xac,0x80
-    ,0xfc,0x90,0x3c,0xbc,0x48,0x00,0x88,0x00,0x80,0x80,0x00,0x7c,0xa4,0x30,0x00,0xf8,0x88,0x4c,0x74,0xf0,0xc8,0x30,0xac,0x80
-    ,0xe4,0xd4,0x3c,0xc0,0xb4,0x18,0xfc,0x54,0x04,0xf4,0x48,0x00,0xc4,0x98,0x04,0xf4,0xc8,0x30,0x54,0xe0,0xf0,0x04,0x90,0xa0
-    ,0x64,0xe4,0x80,0x7c,0xf8,0x94,0xd0,0xdc,0x24,0xcc,0xd8,0x24,0x88,0xf8,0x78,0x7c,0xec,0x70,0x34,0x98,0xfc,0x00,0x54,0xc0
-};
-
-static const uint8_t PROGMEM COLOR_SWIRL_2_LEFT[] = {
-    0x00,0x3c,0xd0,0x24,0x64,0xf4,0x00,0xa8,0xec,0x08,0xb0,0xf4,0x1c,0x78,0xfc,0x00,0x50,0xdc,0x80,0x00,0x50,0xa4,0x28,0x74
-    ,0x08,0xa4,0xbc,0x3c,0xd8,0xf4,0x78,0xfc,0x74,0x7c,0xfc,0x74,0x48,0xec,0xe8,0x18,0xb8,0xb4,0x50,0x28,0xb0,0x44,0x1c,0xa4
-    ,0x70,0xdc,0x78,0x88,0xf4,0x90,0xfc,0xa8,0x00,0xf0,0x9c,0x00,0x90,0xe8,0x78,0x88,0xe0,0x70,0x40,0x60,0xe4,0x0c,0x2c,0xb0
-    ,0xcc,0xd8,0x54,0xb0,0xbc,0x38,0xd8,0x28,0x28,0xc0,0x10,0x10,0x94,0xb4,0x50,0xb8,0xdc,0x74,0x40,0x74,0xe4,0x00,0x34,0xa8
-    ,0xf4,0xc8,0x50,0xb8,0x88,0x14,0x4c,0x1c,0x78,0x6c,0x3c,0x98,0x50,0xf0,0xc8,0x40,0xe0,0xb4,0x44,0x4c,0xd0,0x20,0x24,0xa8
-    ,0xf4,0xc8,0x4c,0xb8,0x8c,0x10,0x50,0x1c,0x90,0x5c,0x28,0x9c,0x04,0x88,0xfc,0x00,0x74,0xfc,0x64,0x0c,0x84,0x70,0x18,0x90
-    ,0xc8,0xd8,0x50,0xb0,0xc0,0x34,0xc4,0x2c,0x5c,0x98,0x00,0x30,0x54,0x04,0xb0,0x54,0x04,0xb0,0xa8,0x0c,0x18,0xdc,0x40,0x50
-    ,0x70,0xd8,0x70,0x88,0xf4,0x88,0xfc,0x88,0x1c,0xd8,0x58,0x00,0xdc,0x28,0x18,0xe4,0x30,0x20,0xd4,0x74,0x00,0xfc,0xa4,0x24
-};
-
-static const uint8_t PROGMEM COLOR_SWIRL_2_RIGHT[] = {
-    0xa4,0x28,0x74,0x80,0x00,0x50,0x00,0x50,0xdc,0x1c,0x78,0xfc,0x08,0xb0,0xf4,0x00,0xa8,0xec,0x24,0x64,0xf4,0x00,0x3c,0xd0
-    ,0x44,0x1c,0xa4,0x50,0x28,0xb0,0x18,0xb8,0xb4,0x48,0xec,0xe8,0x7c,0xfc,0x74,0x78,0xfc,0x74,0x3c,0xd8,0xf4,0x08,0xa4,0xbc
-    ,0x0c,0x2c,0xb0,0x40,0x60,0xe4,0x88,0xe0,0x70,0x90,0xe8,0x78,0xf0,0x9c,0x00,0xfc,0xa8,0x00,0x88,0xf4,0x90,0x70,0xdc,0x78
-    ,0x00,0x34,0xa8,0x40,0x74,0xe4,0xb8,0xdc,0x74,0x94,0xb4,0x50,0xc0,0x10,0x10,0xd8,0x28,0x28,0xb0,0xbc,0x38,0xcc,0xd8,0x54
-    ,0x20,0x24,0xa8,0x44,0x4c,0xd0,0x40,0xe0,0xb4,0x50,0xf0,0xc8,0x6c,0x3c,0x98,0x4c,0x1c,0x78,0xb8,0x88,0x14,0xf4,0xc8,0x50
-    ,0x70,0x18,0x90,0x64,0x0c,0x84,0x00,0x74,0xfc,0x04,0x88,0xfc,0x5c,0x28,0x9c,0x50,0x1c,0x90,0xb8,0x8c,0x10,0xf4,0xc8,0x4c
-    ,0xdc,0x40,0x50,0xa8,0x0c,0x18,0x54,0x04,0xb0,0x54,0x04,0xb0,0x98,0x00,0x30,0xc4,0x2c,0x5c,0xb0,0xc0,0x34,0xc8,0xd8,0x50
-    ,0xfc,0xa4,0x24,0xd4,0x74,0x00,0xe4,0x30,0x20,0xdc,0x28,0x18,0xd8,0x58,0x00,0xfc,0x88,0x1c,0x88,0xf4,0x88,0x70,0xd8,0x70
-};
-
-static const uint8_t PROGMEM COLOR_SWIRL_3_LEFT[] = {
-    0x44,0xd4,0x98,0x64,0xf4,0xb8,0xac,0xf0,0x48,0xa8,0xf0,0x44,0x70,0xfc,0xa0,0x58,0xe8,0x88,0x30,0x80,0xfc,0x00,0x48,0xc4
-    ,0xc8,0xe0,0x44,0xb8,0xd0,0x34,0xfc,0x78,0x00,0xfc,0x70,0x00,0xc0,0xb8,0x18,0xe0,0xd8,0x38,0x4c,0xd4,0xf8,0x00,0x84,0xac
-    ,0xfc,0xa0,0x34,0xc4,0x5c,0x00,0xb0,0x04,0x5c,0xa4,0x00,0x50,0xb0,0x44,0x00,0xfc,0x94,0x40,0x70,0xf0,0xd0,0x28,0xa8,0x88
-    ,0xec,0x64,0x58,0x9c,0x18,0x0c,0x20,0x24,0xd8,0x38,0x3c,0xec,0x80,0x28,0x04,0xdc,0x84,0x60,0x80,0xf0,0xc0,0x3c,0xac,0x7c
-    ,0xc0,0x4c,0x78,0x7c,0x08,0x34,0x14,0x74,0xa4,0x68,0xc8,0xf4,0xbc,0x98,0x00,0xe4,0xc0,0x20,0x6c,0xe8,0xe4,0x1c,0x98,0x98
-    ,0xc8,0x48,0x74,0x84,0x08,0x34,0x00,0x74,0xac,0x54,0xc8,0xfc,0x74,0xfc,0x80,0x6c,0xfc,0x78,0x3c,0xac,0xfc,0x00,0x64,0xbc
-    ,0xf4,0x68,0x58,0xa4,0x18,0x08,0x04,0x30,0xc8,0x34,0x60,0xf4,0x00,0xac,0xfc,0x00,0xa4,0xf8,0x34,0x40,0xdc,0x18,0x20,0xbc
-    ,0xfc,0xa0,0x38,0xc4,0x5c,0x00,0x78,0x0c,0x88,0x6c,0x00,0x80,0x30,0x20,0xd4,0x2c,0x1c,0xd0,0x80,0x00,0x60,0x98,0x18,0x78
-};
-
-static const uint8_t PROGMEM COLOR_SWIRL_3_RIGHT[] = {
-    0x00,0x48,0xc4,0x30,0x80,0xfc,0x58,0xe8,0x88,0x70,0xfc,0xa0,0xa8,0xf0,0x44,0xac,0xf0,0x48,0x64,0xf4,0xb8,0x44,0xd4,0x98
-    ,0x00,0x84,0xac,0x4c,0xd4,0xf8,0xe0,0xd8,0x38,0xc0,0xb8,0x18,0xfc,0x70,0x00,0xfc,0x78,0x00,0xb8,0xd0,0x34,0xc8,0xe0,0x44
-    ,0x28,0xa8,0x88,0x70,0xf0,0xd0,0xfc,0x94,0x40,0xb0,0x44,0x00,0xa4,0x00,0x50,0xb0,0x04,0x5c,0xc4,0x5c,0x00,0xfc,0xa0,0x34
-    ,0x3c,0xac,0x7c,0x80,0xf0,0xc0,0xdc,0x84,0x60,0x80,0x28,0x04,0x38,0x3c,0xec,0x20,0x24,0xd8,0x9c,0x18,0x0c,0xec,0x64,0x58
-    ,0x1c,0x98,0x98,0x6c,0xe8,0xe4,0xe4,0xc0,0x20,0xbc,0x98,0x00,0x68,0xc8,0xf4,0x14,0x74,0xa4,0x7c,0x08,0x34,0xc0,0x4c,0x78
-    ,0x00,0x64,0xbc,0x3c,0xac,0xfc,0x6c,0xfc,0x78,0x74,0xfc,0x80,0x54,0xc8,0xfc,0x00,0x74,0xac,0x84,0x08,0x34,0xc8,0x48,0x74
-    ,0x18,0x20,0xbc,0x34,0x40,0xdc,0x00,0xa4,0xf8,0x00,0xac,0xfc,0x34,0x60,0xf4,0x04,0x30,0xc8,0xa4,0x18,0x08,0xf4,0x68,0x58
-    ,0x98,0x18,0x78,0x80,0x00,0x60,0x2c,0x1c,0xd0,0x30,0x20,0xd4,0x6c,0x00,0x80,0x78,0x0c,0x88,0xc4,0x5c,0x00,0xfc,0xa0,0x38
-};
-
-static const uint8_t PROGMEM COLOR_SWIRL_4_LEFT[] = {
-    0xf8,0xbc,0x28,0xd4,0x98,0x04,0xf4,0x50,0x0c,0xf0,0x48,0x08,0xd8,0x7c,0x00,0xfc,0xa8,0x18,0x78,0xf4,0xa4,0x54,0xd0,0x80
-    ,0xf4,0x58,0x3c,0xb8,0x1c,0x04,0x7c,0x00,0x88,0x78,0x00,0x88,0xac,0x0c,0x14,0xdc,0x3c,0x48,0xac,0xd0,0x44,0xb8,0xdc,0x50
-    ,0x88,0x1c,0x80,0x70,0x04,0x68,0x00,0x50,0xfc,0x08,0x5c,0xfc,0x64,0x14,0x84,0x68,0x18,0x88,0xb8,0x98,0x14,0xec,0xcc,0x48
-    ,0x2c,0x20,0xa4,0x48,0x3c,0xc0,0x20,0xd0,0xd0,0x38,0xec,0xe8,0x64,0x48,0xac,0x3c,0x20,0x84,0xb4,0x84,0x10,0xf4,0xc8,0x50
-    ,0x04,0x34,0xa8,0x40,0x70,0xe4,0xac,0xdc,0x7c,0x8c,0xc0,0x60,0xa4,0x08,0x30,0xb4,0x18,0x40,0xb0,0xac,0x28,0xd8,0xd4,0x50
-    ,0x08,0x30,0xac,0x40,0x68,0xe4,0xa0,0xe0,0x68,0x98,0xd8,0x60,0xf4,0x74,0x00,0xfc,0x84,0x00,0x94,0xec,0x74,0x88,0xe0,0x6c
-    ,0x30,0x20,0xac,0x48,0x38,0xc0,0x30,0xc8,0xa0,0x5c,0xf8,0xcc,0xa4,0xf8,0x4c,0xa0,0xf8,0x48,0x50,0xec,0xe0,0x1c,0xb4,0xac
-    ,0x8c,0x20,0x84,0x70,0x08,0x6c,0x00,0x6c,0xd8,0x20,0x9c,0xfc,0x18,0xd0,0xe0,0x14,0xc8,0xd8,0x20,0x84,0xfc,0x00,0x54,0xd4
-};
-
-static const uint8_t PROGMEM COLOR_SWIRL_4_RIGHT[] = {
-    0x54,0xd0,0x80,0x78,0xf4,0xa4,0xfc,0xa8,0x18,0xd8,0x7c,0x00,0xf0,0x48,0x08,0xf4,0x50,0x0c,0xd4,0x98,0x04,0xf8,0xbc,0x28
-    ,0xb8,0xdc,0x50,0xac,0xd0,0x44,0xdc,0x3c,0x48,0xac,0x0c,0x14,0x78,0x00,0x88,0x7c,0x00,0x88,0xb8,0x1c,0x04,0xf4,0x58,0x3c
-    ,0xec,0xcc,0x48,0xb8,0x98,0x14,0x68,0x18,0x88,0x64,0x14,0x84,0x08,0x5c,0xfc,0x00,0x50,0xfc,0x70,0x04,0x68,0x88,0x1c,0x80
-    ,0xf4,0xc8,0x50,0xb4,0x84,0x10,0x3c,0x20,0x84,0x64,0x48,0xac,0x38,0xec,0xe8,0x20,0xd0,0xd0,0x48,0x3c,0xc0,0x2c,0x20,0xa4
-    ,0xd8,0xd4,0x50,0xb0,0xac,0x28,0xb4,0x18,0x40,0xa4,0x08,0x30,0x8c,0xc0,0x60,0xac,0xdc,0x7c,0x40,0x70,0xe4,0x04,0x34,0xa8
-    ,0x88,0xe0,0x6c,0x94,0xec,0x74,0xfc,0x84,0x00,0xf4,0x74,0x00,0x98,0xd8,0x60,0xa0,0xe0,0x68,0x40,0x68,0xe4,0x08,0x30,0xac
-    ,0x1c,0xb4,0xac,0x50,0xec,0xe0,0xa0,0xf8,0x48,0xa4,0xf8,0x4c,0x5c,0xf8,0xcc,0x30,0xc8,0xa0,0x48,0x38,0xc0,0x30,0x20,0xac
-    ,0x00,0x54,0xd4,0x20,0x84,0xfc,0x14,0xc8,0xd8,0x18,0xd0,0xe0,0x20,0x9c,0xfc,0x00,0x6c,0xd8,0x70,0x08,0x6c,0x8c,0x20,0x84
-};
+#include "Sprite.h"
+
+static const uint8_t PROGMEM BEER_DATA[] = {
+    0x08,0x08,0x01,0x0a,0x00,0x00,0x00,0xe5,0xe5,0xe5,0xd5,0xd0,0x3f,0xd5,0xbb,0x3f,
+    0xc3,0xc3,0xc3,0xd8,0xa6,0x21,0x9b,0x61,0x0f,0xd7,0xc9,0xa4,0xe8,0xd2,0x59,0xeb,
+    0xed,0x59,0x00,0x41,0x10,0x41,0x08,0x01,0x00,0x01,0x08,0x21,0x13,0x00,0x01,0x03,
+    0x09,0x01,0x13,0x14,0x00,0x07,0x13,0x12,0x00,0x04,0x00,0x07,0x32,0x00,0x04,0x00,
+    0x42,0x04,0x10,0x06,0x25,0x06,0x10
+};
+static const Sprite BEER = { BEER_DATA, 0 };
+
+static const uint8_t PROGMEM CHERRIES_DATA[] = {
+    0x08,0x08,0x01,0x04,0x00,0x00,0x00,0xe9,0x00,0x00,0x00,0x90,0x33,0xff,0xff,0xff,
+    0x30,0x22,0x30,0x02,0x00,0x02,0x30,0x02,0x10,0x02,0x30,0x02,0x10,0x11,0x10,0x11,
+    0x00,0x11,0x03,0x21,0x03,0x01,0x00,0x61,0x00,0x11,0x10,0x11,0x40
+};
+static const Sprite CHERRIES = { CHERRIES_DATA, 0 };
+
+static const uint8_t PROGMEM COLOR_SWIRL_1_LEFT_DATA[] = {
+    0x08,0x08,0x00,0xb8,0x24,0x60,0x98,0x04,0x3c,0x50,0x08,0xb0,0x50,0x08,0xb0,0x88,
+    0x00,0x58,0x9c,0x14,0x70,0xc4,0x74,0x00,0xfc,0xb4,0x34,0x30,0x18,0xb0,0x40,0x28,
+    0xc0,0x00,0x7c,0xfc,0x00,0x88,0xfc,0x38,0x40,0xe0,0x18,0x20,0xc0,0xac,0x24,0x00,
+    0xfc,0x74,0x4c,0x00,0x54,0xc0,0x34,0x98,0xfc,0x48,0xf4,0xa0,0x50,0xfc,0xac,0x44,
+    0xb4,0xfc,0x00,0x68,0xb8,0x88,0x08,0x2c,0xd0,0x50,0x70,0x0c,0x94,0xa0,0x58,0xe0,
+    0xec,0xd4,0xd4,0x20,0xc0,0xc0,0x0c,0x74,0xd8,0xf4,0x18,0x7c,0x98,0x78,0x08,0x3c,
+    0xb8,0x48,0x7c,0x34,0xac,0x80,0x78,0xf0,0xc4,0xe4,0x88,0x54,0x90,0x34,0x00,0x38,
+    0x64,0xfc,0x14,0x3c,0xd8,0x90,0x10,0x18,0xdc,0x5c,0x64,0x30,0xac,0x80,0x74,0xf0,
+    0xc8,0xf8,0x88,0x4c,0xa4,0x30,0x00,0x80,0x00,0x7c,0x88,0x00,0x80,0xbc,0x48,0x00,
+    0xfc,0x90,0x3c,0x04,0x90,0xa0,0x54,0xe0,0xf0,0xf4,0xc8,0x30,0xc4,0x98,0x04,0xf4,
+    0x48,0x00,0xfc,0x54,0x04,0xc0,0xb4,0x18,0xe4,0xd4,0x3c,0x00,0x54,0xc0,0x34,0x98,
+    0xfc,0x7c,0xec,0x70,0x88,0xf8,0x78,0xcc,0xd8,0x24,0xd0,0xdc,0x24,0x7c,0xf8,0x94,
+    0x64,0xe4,0x80
+};
+static const Sprite COLOR_SWIRL_1_LEFT = { COLOR_SWIRL_1_LEFT_DATA, 0 };
+
+static const Sprite COLOR_SWIRL_1_RIGHT = { COLOR_SWIRL_1_LEFT_DATA, SPRITE_MIRROR_X };
+
+static const uint8_t PROGMEM COLOR_SWIRL_2_LEFT_DATA[] = {
+    0x08,0x08,0x00,0x00,0x3c,0xd0,0x24,0x64,0xf4,0x00,0xa8,0xec,0x08,0xb0,0xf4,0x1c,
+    0x78,0xfc,0x00,0x50,0xdc,0x80,0x00,0x50,0xa4,0x28,0x74,0x08,0xa4,0xbc,0x3c,0xd8,
+    0xf4,0x78,0xfc,0x74,0x7c,0xfc,0x74,0x48,0xec,0xe8,0x18,0xb8,0xb4,0x50,0x28,0xb0,
+    0x44,0x1c,0xa4,0x70,0xdc,0x78,0x88,0xf4,0x90,0xfc,0xa8,0x00,0xf0,0x9c,0x00,0x90,
+    0xe8,0x78,0x88,0xe0,0x70,0x40,0x60,0xe4,0x0c,0x2c,0xb0,0xcc,0xd8,0x54,0xb0,0xbc,
+    0x38,0xd8,0x28,0x28,0xc0,0x10,0x10,0x94,0xb4,0x50,0xb8,0xdc,0x74,0x40,0x74,0xe4,
+    0x00,0x34,0xa8,0xf4,0xc8,0x50,0xb8,0x88,0x14,0x4c,0x1c,0x78,0x6c,0x3c,0x98,0x50,
+    0xf0,0xc8,0x40,0xe0,0xb4,0x44,0x4c,0xd0,0x20,0x24,0xa8,0xf4,0xc8,0x4c,0xb8,0x8c,
+    0x10,0x50,0x1c,0x90,0x5c,0x28,0x9c,0x04,0x88,0xfc,0x00,0x74,0xfc,0x64,0x0c,0x84,
+    0x70,0x18,0x90,0xc8,0xd8,0x50,0xb0,0xc0,0x34,0xc4,0x2c,0x5c,0x98,0x00,0x30,0x54,
+    0x04,0xb0,0x54,0x04,0xb0,0xa8,0x0c,0x18,0xdc,0x40,0x50,0x70,0xd8,0x70,0x88,0xf4,
+    0x88,0xfc,0x88,0x1c,0xd8,0x58,0x00,0xdc,0x28,0x18,0xe4,0x30,0x20,0xd4,0x74,0x00,
+    0xfc,0xa4,0x24
+};
+static const Sprite COLOR_SWIRL_2_LEFT = { COLOR_SWIRL_2_LEFT_DATA, 0 };
+
+static const Sprite COLOR_SWIRL_2_RIGHT = { COLOR_SWIRL_2_LEFT_DATA, SPRITE_MIRROR_X };
+
+static const uint8_t PROGMEM COLOR_SWIRL_3_LEFT_DATA[] = {
+    0x08,0x08,0x00,0x44,0xd4,0x98,0x64,0xf4,0xb8,0xac,0xf0,0x48,0xa8,0xf0,0x44,0x70,
+    0xfc,0xa0,0x58,0xe8,0x88,0x30,0x80,0xfc,0x00,0x48,0xc4,0xc8,0xe0,0x44,0xb8,0xd0,
+    0x34,0xfc,0x78,0x00,0xfc,0x70,0x00,0xc0,0xb8,0x18,0xe0,0xd8,0x38,0x4c,0xd4,0xf8,
+    0x00,0x84,0xac,0xfc,0xa0,0x34,0xc4,0x5c,0x00,0xb0,0x04,0x5c,0xa4,0x00,0x50,0xb0,
+    0x44,0x00,0xfc,0x94,0x40,0x70,0xf0,0xd0,0x28,0xa8,0x88,0xec,0x64,0x58,0x9c,0x18,
+    0x0c,0x20,0x24,0xd8,0x38,0x3c,0xec,0x80,0x28,0x04,0xdc,0x84,0x60,0x80,0xf0,0xc0,
+    0x3c,0xac,0x7c,0xc0,0x4c,0x78,0x7c,0x08,0x34,0x14,0x74,0xa4,0x68,0xc8,0xf4,0xbc,
+    0x98,0x00,0xe4,0xc0,0x20,0x6c,0xe8,0xe4,0x1c,0x98,0x98,0xc8,0x48,0x74,0x84,0x08,
+    0x34,0x00,0x74,0xac,0x54,0xc8,0xfc,0x74,0xfc,0x80,0x6c,0xfc,0x78,0x3c,0xac,0xfc,
+    0x00,0x64,0xbc,0xf4,0x68,0x58,0xa4,0x18,0x08,0x04,0x30,0xc8,0x34,0x60,0xf4,0x00,
+    0xac,0xfc,0x00,0xa4,0xf8,0x34,0x40,0xdc,0x18,0x20,0xbc,0xfc,0xa0,0x38,0xc4,0x5c,
+    0x00,0x78,0x0c,0x88,0x6c,0x00,0x80,0x30,0x20,0xd4,0x2c,0x1c,0xd0,0x80,0x00,0x60,
+    0x98,0x18,0x78
+};
+static const Sprite COLOR_SWIRL_3_LEFT = { COLOR_SWIRL_3_LEFT_DATA, 0 };
+
+static const Sprite COLOR_SWIRL_3_RIGHT = { COLOR_SWIRL_3_LEFT_DATA, SPRITE_MIRROR_X };
+
+static const uint8_t PROGMEM COLOR_SWIRL_4_LEFT_DATA[] = {
+    0x08,0x08,0x00,0xf8,0xbc,0x28,0xd4,0x98,0x04,0xf4,0x50,0x0c,0xf0,0x48,0x08,0xd8,
+    0x7c,0x00,0xfc,0xa8,0x18,0x78,0xf4,0xa4,0x54,0xd0,0x80,0xf4,0x58,0x3c,0xb8,0x1c,
+    0x04,0x7c,0x00,0x88,0x78,0x00,0x88,0xac,0x0c,0x14,0xdc,0x3c,0x48,0xac,0xd0,0x44,
+    0xb8,0xdc,0x50,0x88,0x1c,0x80,0x70,0x04,0x68,0x00,0x50,0xfc,0x08,0x5c,0xfc,0x64,
+    0x14,0x84,0x68,0x18,0x88,0xb8,0x98,0x14,0xec,0xcc,0x48,0x2c,0x20,0xa4,0x48,0x3c,
+    0xc0,0x20,0xd0,0xd0,0x38,0xec,0xe8,0x64,0x48,0xac,0x3c,0x20,0x84,0xb4,0x84,0x10,
+    0xf4,0xc8,0x50,0x04,0x34,0xa8,0x40,0x70,0xe4,0xac,0xdc,0x7c,0x8c,0xc0,0x60,0xa4,
+    0x08,0x30,0xb4,0x18,0x40,0xb0,0xac,0x28,0xd8,0xd4,0x50,0x08,0x30,0xac,0x40,0x68,
+    0xe4,0xa0,0xe0,0x68,0x98,0xd8,0x60,0xf4,0x74,0x00,0xfc,0x84,0x00,0x94,0xec,0x74,
+    0x88,0xe0,0x6c,0x30,0x20,0xac,0x48,0x38,0xc0,0x30,0xc8,0xa0,0x5c,0xf8,0xcc,0xa4,
+    0xf8,0x4c,0xa0,0xf8,0x48,0x50,0xec,0xe0,0x1c,0xb4,0xac,0x8c,0x20,0x84,0x70,0x08,
+    0x6c,0x00,0x6c,0xd8,0x20,0x9c,0xfc,0x18,0xd0,0xe0,0x14,0xc8,0xd8,0x20,0x84,0xfc,
+    0x00,0x54,0xd4
+};
+static const Sprite COLOR_SWIRL_4_LEFT = { COLOR_SWIRL_4_LEFT_DATA, 0 };
+
+static const Sprite COLOR_SWIRL_4_RIGHT = { COLOR_SWIRL_4_LEFT_DATA, SPRITE_MIRROR_X };
+
+static const uint8_t PROGMEM EYE_BLINK_DATA[] = {
+    0x08,0x08,0x01,0x02,0x00,0x00,0x00,0xd5,0xd5,0xd5,0xf0,0x70,0x01,0x50,0x31,0x10,
+    0x21,0x00,0x51,0xf0,0x00
+};
+static const Sprite EYE_BLINK = { EYE_BLINK_DATA, 0 };
+
+static const uint8_t PROGMEM EYE_CENTER_DATA[] = {
+    0x08,0x08,0x01,0x05,0x00,0x00,0x00,0xd5,0xd5,0xd5,0x00,0x29,0x57,0x00,0x78,0xff,
+    0xa0,0xcd,0xff,0x90,0x31,0x20,0x01,0x04,0x12,0x04,0x01,0x00,0x11,0x02,0x13,0x02,
+    0x31,0x02,0x13,0x02,0x11,0x00,0x01,0x04,0x12,0x04,0x01,0x20,0x31,0x90
+};
+static const Sprite EYE_CENTER = { EYE_CENTER_DATA, 0 };
+
+static const uint8_t PROGMEM EYE_DOWN_DATA[] = {
+    0x08,0x08,0x01,0x05,0x00,0x00,0x00,0xd5,0xd5,0xd5,0x00,0x29,0x57,0x00,0x78,0xff,
+    0xa0,0xcd,0xff,0x90,0x31,0x20,0x51,0x00,0x11,0x04,0x12,0x04,0x31,0x02,0x13,0x02,
+    0x11,0x00,0x01,0x02,0x13,0x02,0x01,0x20,0x04,0x12,0x04,0x90
+};
+static const Sprite EYE_DOWN = { EYE_DOWN_DATA, 0 };
+
+static const uint8_t PROGMEM EYE_LEFT_DATA[] = {
+    0x08,0x08,0x01,0x05,0x00,0x00,0x00,0xd5,0xd5,0xd5,0x00,0x29,0x57,0x00,0x78,0xff,
+    0xa0,0xcd,0xff,0x90,0x31,0x20,0x04,0x12,0x04,0x11,0x00,0x01,0x02,0x13,0x02,0x31,
+    0x02,0x13,0x02,0x21,0x00,0x04,0x12,0x04,0x11,0x20,0x31,0x90
+};
+static const Sprite EYE_LEFT = { EYE_LEFT_DATA, 0 };
+
+static const Sprite EYE_RIGHT = { EYE_LEFT_DATA, SPRITE_MIRROR_X };
+
+static const Sprite EYE_UP = { EYE_DOWN_DATA, SPRITE_MIRROR_Y };
+
+static const uint8_t PROGMEM HEART_DATA[] = {
+    0x08,0x08,0x01,0x02,0x00,0x00,0x00,0xff,0xff,0xff,0x00,0x11,0x10,0x11,0x00,0xf1,
+    0x71,0x00,0x51,0x20,0x31,0x40,0x11,0xa0
+};
+static const Sprite HEART = { HEART_DATA, 0 };
+
+static const uint8_t PROGMEM MARIO_DATA[] = {
+    0x08,0x08,0x01,0x0a,0x00,0x00,0x00,0xf0,0x03,0x03,0xcc,0xc3,0xa2,0x1b,0xd1,0xe1,
+    0x74,0x4c,0x00,0x6f,0x2e,0x02,0x9f,0x43,0x00,0xf2,0xdb,0x15,0xff,0xff,0xff,0xae,
+    0xae,0xae,0x20,0x21,0x08,0x30,0x41,0x10,0x04,0x02,0x04,0x00,0x02,0x20,0x04,0x12,
+    0x16,0x02,0x30,0x22,0x10,0x11,0x07,0x13,0x07,0x00,0x08,0x10,0x23,0x00,0x09,0x20,
+    0x05,0x10,0x05,0x00
+};
+static const Sprite MARIO = { MARIO_DATA, 0 };
 
 #endif
@@ -0,0 +1,367 @@
+/**
+ *  Host (Linux) implementation of Hal.h
+ *
+ *  Capture is modelled on the SAMD21 one: from halSampleBegin() a block of
+ *  SAMPLE_BLOCK completes every SAMPLE_BLOCK / SAMPLE_RATE of virtual time, the
+ *  stream is gap-free, and only the newest completed block can be read; any
+ *  older unread block counts as an overrun, like a DMA buffer overwritten
+ *  before the firmware got to it.
+ *
+ *  Pixel transports follow the SAMD21's choice by pins. A pair it drives with
+ *  SPI over DMA copies the frame and passes it on at submit(), and stays busy
+ *  for the time PIXEL_SPI_CLOCK needs to shift it out; the virtual clock
+ *  cannot move while firmware code runs, so wait() just ends the transfer
+ *  early and DotStarOutput counts those waits. Any other pair is bit-banged on
+ *  the device, so submit() holds the caller up: it moves the virtual clock on
+ *  by the time PIXEL_BITBANG_CLOCK needs and charges the same time to
+ *  halProfileMicros() and halProfileCycles(), so task and stage timings,
+ *  deadlines and capture overruns all see the stall.
+ */
+
+#include <chrono>
+#include <vector>
+
+#include "Hal.h"
+#include "HalHost.h"
+
+static uint64_t now = 0;
+// Modelled time the host did not spend itself, see HostBitBangTransport
+static uint64_t stalled = 0;
+
+static uint16_t rawSamples[SAMPLE_BLOCK];
+static bool capturing = false;
+static uint64_t captureStart = 0;
+static uint32_t availableBlock = 0;
+static uint32_t consumedBlocks = 0;
+static uint32_t overruns = 0;
+
+static std::vector<float> audio;
+static uint32_t audioRate = SAMPLE_RATE;
+static bool synthetic = true;
+static bool finished = false;
+
+static uint32_t randomState = 1;
+
+static HostPixelSink pixelSink = NULL;
+static void *pixelSinkContext = NULL;
+static FILE *serialOutput = NULL;
+
+static uint32_t readLittleEndian(const uint8_t *p, uint8_t bytes) {
+    uint32_t value = 0;
+    for (uint8_t i = 0; i < bytes; i++) {
+        value |= (uint32_t)p[i] << (8 * i);
+    }
+
+    return value;
+}
+
+/**
+ * Load a 16-bit PCM WAV file, keeping only the first channel
+ */
+bool hostAudioOpen(const char *path) {
+    FILE *file = fopen(path, "rb");
+    if (file == NULL) {
+        return false;
+    }
+
+    std::vector<uint8_t> data;
+    uint8_t buffer[4096];
+    size_t read;
+    while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        data.insert(data.end(), buffer, buffer + read);
+    }
+    fclose(file);
+
+    if (data.size() < 12 || memcmp(&data[0], "RIFF", 4) != 0 || memcmp(&data[8], "WAVE", 4) != 0) {
+        return false;
+    }
+
+    uint16_t channels = 0;
+    uint16_t bits = 0;
+    size_t position = 12;
+    while (position + 8 <= data.size()) {
+        const uint8_t *chunk = &data[position];
+        uint32_t size = readLittleEndian(chunk + 4, 4);
+        const uint8_t *body = chunk + 8;
+        if (position + 8 + size > data.size()) {
+            size = data.size() - position - 8;
+        }
+
+        if (memcmp(chunk, "fmt ", 4) == 0 && size >= 16) {
+            if (readLittleEndian(body, 2) != 1) {
+                return false;
+            }
+
+            channels = readLittleEndian(body + 2, 2);
+            audioRate = readLittleEndian(body + 4, 4);
+            bits = readLittleEndian(body + 14, 2);
+        } else if (memcmp(chunk, "data", 4) == 0) {
+            if (channels == 0 || bits != 16 || audioRate == 0) {
+                return false;
+            }
+
+            uint32_t frames = size / (2 * channels);
+            audio.resize(frames);
+            for (uint32_t i = 0; i < frames; i++) {
+                audio[i] = (int16_t)readLittleEndian(body + i * 2 * channels, 2) / 32768.0f;
+            }
+
+            synthetic = false;
+            finished = false;
+            return true;
+        }
+
+        position += 8 + size + (size & 1);
+    }
+
+    return false;
+}
+
+/**
+ * 120 BPM kick, a bass line, off-beat hi-hats and a slowly sweeping lead
+ */
+void hostAudioSynthetic() {
+    audio.clear();
+    audioRate = SAMPLE_RATE;
+    synthetic = true;
+    finished = false;
+}
+
+bool hostAudioFinished() {
+    return finished;
+}
+
+uint32_t hostSampleBlocks() {
+    return consumedBlocks - overruns;
+}
+
+static float syntheticSample(uint64_t n) {
+    double t = (double)n / SAMPLE_RATE;
+    double beat = fmod(t, 0.5);
+    double offBeat = fmod(t + 0.25, 0.5);
+
+    double kick = exp(-beat * 25.0) * sin(2.0 * PI * (45.0 * beat + 2.0 * (1.0 - exp(-beat * 40.0))));
+    double bass = 0.2 * sin(2.0 * PI * (fmod(t, 2.0) < 1.0 ? 110.0 : 82.4) * t);
+
+    uint32_t hash = (uint32_t)n * 2654435761u;
+    hash ^= hash >> 15;
+    double hat = 0.15 * exp(-offBeat * 150.0) * (((hash & 0xFFFF) / 32768.0) - 1.0);
+
+    double lead = 0.08 * sin(2.0 * PI * (1500.0 * t + 400.0 * sin(2.0 * PI * 0.1 * t) / (2.0 * PI * 0.1)));
+
+    return (float)(0.7 * kick + bass + hat + lead);
+}
+
+static float fileSample(uint64_t n) {
+    double position = (double)n * audioRate / SAMPLE_RATE;
+    size_t index = (size_t)position;
+    if (index + 1 >= audio.size()) {
+        finished = true;
+        return 0;
+    }
+
+    float fraction = (float)(position - index);
+    return audio[index] + (audio[index + 1] - audio[index]) * fraction;
+}
+
+static uint16_t sampleToCounts(float value) {
+    float counts = MICROPHONE_LOW + (value + 1.0f) * (MICROPHONE_HIGH - MICROPHONE_LOW) / 2.0f;
+    return (uint16_t)constrain(lroundf(counts), 0, 4095);
+}
+
+// Blocks that have completed since halSampleBegin()
+static uint32_t completedBlocks() {
+    return (uint32_t)((now - captureStart) * SAMPLE_RATE / 1000000 / SAMPLE_BLOCK);
+}
+
+void halSampleBegin() {
+    capturing = true;
+    captureStart = now;
+    availableBlock = 0;
+    consumedBlocks = 0;
+    overruns = 0;
+}
+
+const volatile uint16_t* halSampleAvailable() {
+    if (!capturing) {
+        return NULL;
+    }
+
+    uint32_t completed = completedBlocks();
+    if (completed == consumedBlocks) {
+        return NULL;
+    }
+
+    // Count every block that went by unread once: those since the last one
+    // handed out, and that one too if it was never released
+    if (completed != availableBlock) {
+        overruns += completed - availableBlock - (availableBlock > consumedBlocks ? 0 : 1);
+        availableBlock = completed;
+
+        // Block n (counting from 1) holds the SAMPLE_BLOCK samples before its completion
+        uint64_t first = captureStart * SAMPLE_RATE / 1000000 + (uint64_t)(completed - 1) * SAMPLE_BLOCK;
+        for (int i = 0; i < SAMPLE_BLOCK; i++) {
+            rawSamples[i] = sampleToCounts(synthetic ? syntheticSample(first + i) : fileSample(first + i));
+        }
+    }
+
+    return rawSamples;
+}
+
+void halSampleRelease() {
+    consumedBlocks = availableBlock;
+}
+
+uint32_t halSampleOverruns() {
+    return overruns;
+}
+
+bool halSamplePending() {
+    return capturing && completedBlocks() != consumedBlocks;
+}
+
+bool halIdle() {
+    return !halSamplePending();
+}
+
+uint32_t halMillis() {
+    return (uint32_t)(now / 1000);
+}
+
+uint32_t halMicros() {
+    return (uint32_t)now;
+}
+
+uint32_t halProfileMicros() {
+    return (uint32_t)(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count() + stalled);
+}
+
+uint32_t halProfileCycles() {
+    uint64_t nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count() + stalled * 1000;
+    return (uint32_t)(nanoseconds * (HAL_CPU_CLOCK / 1000000) / 1000);
+}
+
+// Same contract as Arduino's random(), driven by a seeded xorshift
+int32_t halRandom(int32_t maximum) {
+    if (maximum == 0) {
+        return 0;
+    }
+
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 17;
+    randomState ^= randomState << 5;
+
+    return (int32_t)(randomState & 0x7FFFFFFF) % maximum;
+}
+
+int32_t halRandom(int32_t minimum, int32_t maximum) {
+    if (minimum >= maximum) {
+        return minimum;
+    }
+
+    return halRandom(maximum - minimum) + minimum;
+}
+
+void hostAdvance(uint64_t micros) {
+    now += micros;
+}
+
+uint64_t hostNow() {
+    return now;
+}
+
+void hostRandomSeed(uint32_t seed) {
+    randomState = seed != 0 ? seed : 1;
+}
+
+void hostSetPixelSink(HostPixelSink sink, void *context) {
+    pixelSink = sink;
+    pixelSinkContext = context;
+}
+
+// Pairs HalSamd.cpp drives with SPI over DMA, data pin then clock pin
+static const uint8_t hostSpiPins[][2] = {
+    { 11, 12 },
+    { PIN_SPI_MOSI, PIN_SPI_SCK }
+};
+
+static uint64_t transferMicros(uint16_t length, uint32_t clock) {
+    return ((uint64_t)length * 8 * 1000000 + clock - 1) / clock;
+}
+
+class HostPixelTransport : public PixelTransport {
+public:
+    HostPixelTransport(uint8_t pDataPin) {
+        dataPin = pDataPin;
+        doneAt = 0;
+    }
+
+    void submit(const uint8_t *frame, uint16_t length) {
+        this->frame.assign(frame, frame + length);
+        doneAt = now + transferMicros(length, PIXEL_SPI_CLOCK);
+
+        if (pixelSink != NULL) {
+            pixelSink(dataPin, &this->frame[0], length, pixelSinkContext);
+        }
+    }
+
+    bool busy() {
+        return now < doneAt;
+    }
+
+    void wait() {
+        doneAt = now;
+    }
+
+private:
+    uint8_t dataPin;
+    uint64_t doneAt;
+    std::vector<uint8_t> frame;
+};
+
+class HostBitBangTransport : public PixelTransport {
+public:
+    HostBitBangTransport(uint8_t pDataPin) {
+        dataPin = pDataPin;
+    }
+
+    void submit(const uint8_t *frame, uint16_t length) {
+        if (pixelSink != NULL) {
+            pixelSink(dataPin, frame, length, pixelSinkContext);
+        }
+
+        uint64_t duration = transferMicros(length, PIXEL_BITBANG_CLOCK);
+        now += duration;
+        stalled += duration;
+    }
+
+    bool busy() {
+        return false;
+    }
+
+    void wait() {
+    }
+
+private:
+    uint8_t dataPin;
+};
+
+PixelTransport* halPixelTransport(uint8_t dataPin, uint8_t clockPin) {
+    for (uint8_t i = 0; i < sizeof(hostSpiPins) / sizeof(hostSpiPins[0]); i++) {
+        if (hostSpiPins[i][0] == dataPin && hostSpiPins[i][1] == clockPin) {
+            return new HostPixelTransport(dataPin);
+        }
+    }
+
+    return new HostBitBangTransport(dataPin);
+}
+
+void hostSetSerialOutput(FILE *output) {
+    serialOutput = output;
+}
+
+FILE* hostSerialOutput() {
+    return serialOutput;
+}
@@ -0,0 +1,47 @@
+#ifndef _HAL_HOST_H_
+#define _HAL_HOST_H_
+
+/******************************************************************************
+
+Host-only side of the HAL
+
+The native simulation drives a virtual clock instead of a real one: nothing
+moves until hostAdvance() is called, so every run over the same audio is
+reproducible no matter how fast the host is.
+
+Audio comes either from a synthetic 120 BPM test pattern or from a 16-bit PCM
+WAV file, resampled to SAMPLE_RATE and mapped onto the MICROPHONE_LOW..HIGH
+ADC range exactly like the electret amplifier output.
+
+Every frame a PixelTransport sends is passed to the pixel sink, if one is set,
+exactly as it would be clocked out: start frame, 0xFF plus blue, green, red
+(brightness already applied) per pixel, end frame.
+
+******************************************************************************/
+
+#include <stdint.h>
+#include <stdio.h>
+
+typedef void (*HostPixelSink)(uint8_t dataPin, const uint8_t *frame, uint16_t length, void *context);
+
+// Audio
+bool hostAudioOpen(const char *path);
+void hostAudioSynthetic();
+bool hostAudioFinished();
+uint32_t hostSampleBlocks();
+
+// Clock
+void hostAdvance(uint64_t micros);
+uint64_t hostNow();
+
+// RNG
+void hostRandomSeed(uint32_t seed);
+
+// Pixel sink
+void hostSetPixelSink(HostPixelSink sink, void *context);
+
+// Serial
+void hostSetSerialOutput(FILE *output);
+FILE* hostSerialOutput();
+
+#endif
@@ -0,0 +1,58 @@
+#ifndef _BENCHMARK_H_
+#define _BENCHMARK_H_
+
+/******************************************************************************
+
+Microbenchmarks of the firmware's kernels on the host
+
+A benchmark is a function that runs its kernel `iterations` times; the runner
+(bench/main.cpp) picks the count, times it and reports ns and allocations per
+run. Benchmarks register themselves at startup with
+
+    BENCHMARK(group, name) {
+        for (uint32_t i = 0; i < iterations; i++) {
+            ...
+        }
+    }
+
+Everything in a group does the same job, and the first one registered is
+what the rest are compared against, so an alternative (fixed point, a lookup
+table) goes in as another name in the same group, in any file under bench/.
+
+Host numbers rank kernels and catch regressions; the M0 has no FPU, no
+cache and a different CMSIS, so they are not cycle counts for the goggles.
+Those come from the goggles themselves: stage times are counted in CPU cycles
+(Profile.h) and telemetry reports them (host/tools/telemetry.py).
+
+Benchmarks that spend their time in CMSIS go in with BENCHMARK_SHIM instead.
+On the host that is the stand-in in host/shims/arm_math.cpp, written to get
+CMSIS's numbers rather than its speed, so their times are the shim's: the
+runner marks them and leaves them out of the comparisons. The spectrum stage
+in telemetry is what the FFT and magnitudes really take on the M0.
+
+******************************************************************************/
+
+#include <stdint.h>
+
+typedef void (*BenchmarkFunction)(uint32_t iterations);
+
+struct BenchmarkRegistration {
+    BenchmarkRegistration(const char *group, const char *name, BenchmarkFunction function, bool shim = false);
+};
+
+// Keep the compiler from optimising away a result nobody reads
+inline void benchmarkKeep(const void *value) {
+    asm volatile("" : : "g"(value) : "memory");
+}
+
+#define BENCHMARK(group, name) \
+    static void benchmark_##group##_##name(uint32_t iterations); \
+    static BenchmarkRegistration registration_##group##_##name(#group, #name, benchmark_##group##_##name); \
+    static void benchmark_##group##_##name(uint32_t iterations)
+
+#define BENCHMARK_SHIM(group, name) \
+    static void benchmark_##group##_##name(uint32_t iterations); \
+    static BenchmarkRegistration registration_##group##_##name(#group, #name, benchmark_##group##_##name, true); \
+    static void benchmark_##group##_##name(uint32_t iterations)
+
+#endif
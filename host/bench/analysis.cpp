@@ -0,0 +1,203 @@
+/**
+ *  Analysis kernels: the whole per-block loop, then its parts with the
+ *  alternatives the firmware can be built with side by side. Whatever runs
+ *  through CMSIS times the host's shims (Benchmark.h).
+ */
+
+#include "AudioVisualizer.h"
+#include "Benchmark.h"
+#include "Filterbank.h"
+#include "HalHost.h"
+#include "NoiseFloor.h"
+#include "SlidingDFT.h"
+
+// Instantiated in SlidingDFT.cpp, at the largest size it takes: FFT_SAMPLES
+// may be past it, and a block costs the same per bin at any size
+extern template class SlidingDFT<64>;
+
+// Whole microseconds, so a block sometimes takes one more step to complete
+#define BLOCK_MICROS    ((uint64_t)SAMPLE_BLOCK * 1000000 / SAMPLE_RATE + 1)
+
+template<int N> struct BenchmarkCfft;
+#define BENCHMARK_CFFT(N) \
+    template<> struct BenchmarkCfft<N> { \
+        static const arm_cfft_instance_f32 *get() { return &arm_cfft_sR_f32_len##N; } \
+    };
+BENCHMARK_CFFT(32)
+BENCHMARK_CFFT(64)
+BENCHMARK_CFFT(128)
+BENCHMARK_CFFT(256)
+
+static Visualizer visualizer;
+
+// Also starts the capture
+static void startVisualizer() {
+    static bool started = false;
+    if (!started) {
+        visualizer.initialize();
+        started = true;
+    }
+}
+
+// Deterministic full scale-ish input, like a loud block off the ADC
+static void fillSamples(q15_t *samples, int count) {
+    uint32_t state = 12345;
+    for (int i = 0; i < count; i++) {
+        state = state * 1664525 + 1013904223;
+        samples[i] = (q15_t)((state >> 16) - 32768) / 4;
+    }
+}
+
+// Capturing a block on the host costs as much as synthesising it, so that
+// is measured on its own and comes off analysis/loop
+BENCHMARK(analysis, capture) {
+    startVisualizer();
+    for (uint32_t i = 0; i < iterations; i++) {
+        hostAdvance(BLOCK_MICROS);
+        benchmarkKeep((const void *)halSampleAvailable());
+        halSampleRelease();
+    }
+}
+
+// Runs the FFT through the shim
+BENCHMARK_SHIM(analysis, loop) {
+    startVisualizer();
+    for (uint32_t i = 0; i < iterations; i++) {
+        hostAdvance(BLOCK_MICROS);
+        visualizer.loop();
+    }
+    benchmarkKeep(&visualizer.getFrame());
+}
+
+BENCHMARK_SHIM(spectrum, rfft_q15) {
+    static arm_rfft_instance_q15 rfft;
+    static q15_t input[FFT_SAMPLES];
+    static q15_t samples[FFT_SAMPLES];
+    static q15_t spectrum[FFT_SAMPLES * 2];
+    static q15_t magnitude[FFT_SAMPLES / 2];
+    arm_rfft_init_q15(&rfft, FFT_SAMPLES, 0, 1);
+    fillSamples(input, FFT_SAMPLES);
+
+    for (uint32_t i = 0; i < iterations; i++) {
+        // arm_rfft_q15 works in place on its input
+        memcpy(samples, input, sizeof(samples));
+        arm_rfft_q15(&rfft, samples, spectrum);
+        complexMagnitudes(spectrum, magnitude, FFT_SAMPLES / 2);
+        benchmarkKeep(magnitude);
+    }
+}
+
+BENCHMARK_SHIM(spectrum, cfft_f32) {
+    static q15_t input[FFT_SAMPLES];
+    static float32_t samples[FFT_SAMPLES * 2];
+    static float32_t magnitude[FFT_SAMPLES];
+    fillSamples(input, FFT_SAMPLES);
+
+    for (uint32_t i = 0; i < iterations; i++) {
+        for (int s = 0; s < FFT_SAMPLES; s++) {
+            samples[s * 2] = input[s] / 32768.0f;
+            samples[s * 2 + 1] = 0;
+        }
+        arm_cfft_f32(BenchmarkCfft<FFT_SAMPLES>::get(), samples, 0, 1);
+        arm_cmplx_mag_f32(samples, magnitude, FFT_SAMPLES);
+        benchmarkKeep(magnitude);
+    }
+}
+
+// One block into the sliding DFT, then all its magnitudes
+BENCHMARK(spectrum, sliding_dft) {
+    static SlidingDFT<64> slidingDFT;
+    static uint16_t block[SAMPLE_BLOCK];
+    static q15_t magnitude[SLIDING_DFT_BINS];
+    for (int s = 0; s < SAMPLE_BLOCK; s++) {
+        block[s] = MICROPHONE_LOW + (s * 97) % (MICROPHONE_HIGH - MICROPHONE_LOW);
+    }
+
+    for (uint32_t i = 0; i < iterations; i++) {
+        slidingDFT.update(block, SAMPLE_BLOCK);
+        slidingDFT.getMagnitudes(magnitude);
+        benchmarkKeep(magnitude);
+    }
+}
+
+BENCHMARK_SHIM(magnitude, q15) {
+    static q15_t spectrum[FFT_SAMPLES];
+    static q15_t magnitude[FFT_SAMPLES / 2];
+    fillSamples(spectrum, FFT_SAMPLES);
+
+    for (uint32_t i = 0; i < iterations; i++) {
+        arm_cmplx_mag_q15(spectrum, magnitude, FFT_SAMPLES / 2);
+        benchmarkKeep(magnitude);
+    }
+}
+
+// What the firmware uses, see FixedPoint.h
+BENCHMARK(magnitude, q15_root32) {
+    static q15_t spectrum[FFT_SAMPLES];
+    static q15_t magnitude[FFT_SAMPLES / 2];
+    fillSamples(spectrum, FFT_SAMPLES);
+
+    for (uint32_t i = 0; i < iterations; i++) {
+        complexMagnitudes(spectrum, magnitude, FFT_SAMPLES / 2);
+        benchmarkKeep(magnitude);
+    }
+}
+
+BENCHMARK_SHIM(magnitude, f32) {
+    static float32_t spectrum[FFT_SAMPLES];
+    static float32_t magnitude[FFT_SAMPLES / 2];
+    for (int s = 0; s < FFT_SAMPLES; s++) {
+        spectrum[s] = (s * 37 % 64) / 64.0f - 0.5f;
+    }
+
+    for (uint32_t i = 0; i < iterations; i++) {
+        arm_cmplx_mag_f32(spectrum, magnitude, FFT_SAMPLES / 2);
+        benchmarkKeep(magnitude);
+    }
+}
+
+// Noise floor tracking, one frame of bins
+BENCHMARK(noisefloor, q15) {
+    static NoiseFloor<q15_t, FFT_SAMPLES / 2> noiseFloor;
+    static q15_t magnitude[FFT_SAMPLES / 2];
+    fillSamples(magnitude, FFT_SAMPLES / 2);
+    noiseFloor.begin(100);
+
+    for (uint32_t i = 0; i < iterations; i++) {
+        magnitude[i % (FFT_SAMPLES / 2)] ^= 0x55;
+        noiseFloor.update(magnitude);
+        benchmarkKeep(&noiseFloor);
+    }
+}
+
+BENCHMARK(noisefloor, f32) {
+    static NoiseFloor<float32_t, FFT_SAMPLES / 2> noiseFloor;
+    static float32_t magnitude[FFT_SAMPLES / 2];
+    for (int b = 0; b < FFT_SAMPLES / 2; b++) {
+        magnitude[b] = (b * 37 % 64) / 64.0f;
+    }
+    noiseFloor.begin(100);
+
+    for (uint32_t i = 0; i < iterations; i++) {
+        magnitude[i % (FFT_SAMPLES / 2)] += 0.01f;
+        noiseFloor.update(magnitude);
+        benchmarkKeep(&noiseFloor);
+    }
+}
+
+// Spectrum to the matrix's 16 columns
+BENCHMARK(filterbank, columns) {
+    static constexpr Filterbank<16, Visualizer::analysisBins, Visualizer::fftSize, Visualizer::sampleRate, COLUMN_SCALE>
+        filterbank = makeFilterbank<16, Visualizer::analysisBins, Visualizer::fftSize, Visualizer::sampleRate, COLUMN_SCALE>();
+    static q15_t levels[FFT_SAMPLES / 2];
+    static uint32_t scratch[16 + 1];
+    static q15_t columns[16];
+    for (int b = 0; b < FFT_SAMPLES / 2; b++) {
+        levels[b] = (b * 37 % 64) * 512;
+    }
+
+    for (uint32_t i = 0; i < iterations; i++) {
+        applyFilterbank(filterbank, levels, scratch, columns);
+        benchmarkKeep(columns);
+    }
+}
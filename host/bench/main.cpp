@@ -0,0 +1,183 @@
+/******************************************************************************
+
+GOGGLES V2 - kernel microbenchmarks
+
+    goggles-bench [--filter TEXT] [--time MS]
+
+        --filter TEXT     Only benchmarks whose group/name contains TEXT
+        --time MS         Wall-clock time per measurement (default 50)
+
+Each benchmark is measured five times and the fastest counts. Allocations
+are every malloc, calloc, realloc and operator new made while it runs, so
+anything but 0 per op in a render or analysis kernel is a bug on the M0.
+Benchmarks timing the host's CMSIS shims are marked "shim" and compared with
+nothing (Benchmark.h); the first benchmark of a group that is not a shim is
+what the others are compared against.
+
+******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <chrono>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "Benchmark.h"
+#include "HalHost.h"
+
+#define MEASUREMENTS    5
+
+struct Benchmark {
+    const char *group;
+    const char *name;
+    BenchmarkFunction function;
+    bool shim;
+};
+
+static std::vector<Benchmark>& benchmarks() {
+    static std::vector<Benchmark> registered;
+    return registered;
+}
+
+BenchmarkRegistration::BenchmarkRegistration(const char *group, const char *name, BenchmarkFunction function,
+                                             bool shim) {
+    Benchmark benchmark = { group, name, function, shim };
+    benchmarks().push_back(benchmark);
+}
+
+// Counted through the linker (-Wl,--wrap), so the firmware's own calls count too
+static uint64_t allocations = 0;
+
+extern "C" {
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t count, size_t size);
+void *__real_realloc(void *pointer, size_t size);
+
+void *__wrap_malloc(size_t size) {
+    allocations++;
+    return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t count, size_t size) {
+    allocations++;
+    return __real_calloc(count, size);
+}
+
+void *__wrap_realloc(void *pointer, size_t size) {
+    allocations++;
+    return __real_realloc(pointer, size);
+}
+}
+
+void *operator new(size_t size) {
+    allocations++;
+    void *pointer = __real_malloc(size > 0 ? size : 1);
+    if (pointer == NULL) {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+void *operator new[](size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void *pointer) noexcept {
+    free(pointer);
+}
+
+void operator delete[](void *pointer) noexcept {
+    free(pointer);
+}
+
+static double measure(BenchmarkFunction function, uint32_t iterations) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    function(iterations);
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+int main(int argc, char **argv) {
+    const char *filter = NULL;
+    double target = 50e6;
+
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--filter") == 0 && hasValue) {
+            filter = argv[++i];
+        } else if (strcmp(argv[i], "--time") == 0 && hasValue) {
+            target = atof(argv[++i]) * 1e6;
+        } else {
+            fprintf(stderr, "usage: %s [--filter TEXT] [--time MS]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    hostAudioSynthetic();
+    hostRandomSeed(1);
+
+    // Groups in the order they first turn up, whichever file their entries are in
+    std::vector<Benchmark> &all = benchmarks();
+    std::vector<std::string> groups;
+    for (size_t b = 0; b < all.size(); b++) {
+        if (std::find(groups.begin(), groups.end(), all[b].group) == groups.end()) {
+            groups.push_back(all[b].group);
+        }
+    }
+    std::stable_sort(all.begin(), all.end(), [&groups](const Benchmark &a, const Benchmark &b) {
+        return std::find(groups.begin(), groups.end(), a.group) < std::find(groups.begin(), groups.end(), b.group);
+    });
+
+    printf("%-12s %-20s %12s %10s %8s\n", "group", "name", "ns/op", "allocs/op", "vs first");
+
+    const char *group = "";
+    double first = 0;
+    for (size_t b = 0; b < all.size(); b++) {
+        const Benchmark &benchmark = all[b];
+        std::string path = std::string(benchmark.group) + "/" + benchmark.name;
+        if (filter != NULL && path.find(filter) == std::string::npos) {
+            continue;
+        }
+
+        // Double the count until a run is long enough to scale from
+        uint32_t iterations = 1;
+        double elapsed;
+        while ((elapsed = measure(benchmark.function, iterations)) < target / 10 && iterations < (1u << 30)) {
+            iterations *= 2;
+        }
+        iterations = (uint32_t)std::min(4e9, std::max(1.0, iterations * target / std::max(elapsed, 1.0)));
+
+        double best = 0;
+        uint64_t allocated = 0;
+        for (int m = 0; m < MEASUREMENTS; m++) {
+            uint64_t before = allocations;
+            double perRun = measure(benchmark.function, iterations) / iterations;
+            allocated = std::max(allocated, allocations - before);
+            if (m == 0 || perRun < best) {
+                best = perRun;
+            }
+        }
+
+        if (strcmp(group, benchmark.group) != 0) {
+            group = benchmark.group;
+            first = 0;
+        }
+        if (benchmark.shim) {
+            printf("%-12s %-20s %12.1f %10.3f %8s\n", benchmark.group, benchmark.name, best,
+                   (double)allocated / iterations, "shim");
+        } else {
+            if (first == 0) {
+                first = best;
+            }
+            printf("%-12s %-20s %12.1f %10.3f %7.2fx\n", benchmark.group, benchmark.name, best,
+                   (double)allocated / iterations, first > 0 ? best / first : 0.0);
+        }
+        fflush(stdout);
+    }
+
+    return 0;
+}
@@ -0,0 +1,225 @@
+/**
+ *  Render kernels: Matrix drawing and effects, DotStar output, Strip and the
+ *  palette
+ */
+
+#include "Benchmark.h"
+#include "HalHost.h"
+#include "Matrix.h"
+#include "MatrixEffect.h"
+#include "Palette.h"
+#include "Strip.h"
+#include "graphics.h"
+
+static Visualizer visualizer;
+static Matrix matrix;
+static Strip strip;
+
+static const Sprite *pictures[] = {
+    &COLOR_SWIRL_1_LEFT, &COLOR_SWIRL_1_RIGHT
+};
+
+static Matrix& startMatrix() {
+    static bool started = false;
+    if (!started) {
+        matrix.initialize(visualizer);
+        started = true;
+    }
+    return matrix;
+}
+
+// One pixel through Adafruit_GFX's 565 colours, expandColor() included
+BENCHMARK(pixel, drawPixel) {
+    Matrix &m = startMatrix();
+    for (uint32_t i = 0; i < iterations; i++) {
+        m.drawPixel(i & 15, (i >> 4) & 7, (uint16_t)i);
+    }
+    benchmarkKeep(m.getPixels());
+}
+
+BENCHMARK(pixel, setPixelRGB) {
+    Matrix &m = startMatrix();
+    for (uint32_t i = 0; i < iterations; i++) {
+        m.setPixelRGB(i & 15, (i >> 4) & 7, i * 0x010203);
+    }
+    benchmarkKeep(m.getPixels());
+}
+
+// A 565 colour to gamma corrected 24 bits, which every 565 pixel goes through
+BENCHMARK(expand, expandColor) {
+    uint32_t color = 0;
+    for (uint32_t i = 0; i < iterations; i++) {
+        color ^= Matrix::expandColor((uint16_t)(i * 0x9E37));
+    }
+    benchmarkKeep(&color);
+}
+
+BENCHMARK(fill, fillScreen) {
+    Matrix &m = startMatrix();
+    for (uint32_t i = 0; i < iterations; i++) {
+        m.fillScreen((uint16_t)i);
+    }
+    benchmarkKeep(m.getPixels());
+}
+
+BENCHMARK(fill, fillRGB) {
+    Matrix &m = startMatrix();
+    for (uint32_t i = 0; i < iterations; i++) {
+        m.fillRGB(0, 0, MATRIX_SIZE * 2, MATRIX_SIZE, i * 0x010203);
+    }
+    benchmarkKeep(m.getPixels());
+}
+
+// Both 8x8 halves from their sprites
+BENCHMARK(sprite, drawPictures) {
+    Matrix &m = startMatrix();
+    for (uint32_t i = 0; i < iterations; i++) {
+        m.drawPictures(pictures, 0);
+    }
+    benchmarkKeep(m.getPixels());
+}
+
+BENCHMARK(sprite, drawSpriteMask) {
+    Matrix &m = startMatrix();
+    for (uint32_t i = 0; i < iterations; i++) {
+        m.drawSpriteMask(0, 0, HEART, 0xFF0080);
+        m.drawSpriteMask(MATRIX_SIZE, 0, HEART, 0xFF0080);
+    }
+    benchmarkKeep(m.getPixels());
+}
+
+// One frame of a registered effect into a cleared buffer, as Matrix::loop() does
+static void renderEffect(const char *name, uint32_t iterations) {
+    Matrix &m = startMatrix();
+    for (uint8_t effect = 0; effect < matrixEffectCount; effect++) {
+        if (strcmp(matrixEffects[effect].name, name) != 0) continue;
+
+        matrixEffects[effect].start(m);
+        for (uint32_t i = 0; i < iterations; i++) {
+            m.clear();
+            matrixEffects[effect].render(m);
+        }
+    }
+    benchmarkKeep(m.getPixels());
+}
+
+BENCHMARK(effect, visualize) {
+    renderEffect("visualize", iterations);
+}
+
+BENCHMARK(effect, color_swirl) {
+    renderEffect("color swirl", iterations);
+}
+
+BENCHMARK(effect, eyes) {
+    renderEffect("eyes", iterations);
+}
+
+BENCHMARK(effect, text) {
+    renderEffect("text", iterations);
+}
+
+BENCHMARK(effect, hearts) {
+    renderEffect("hearts", iterations);
+}
+
+BENCHMARK(effect, beer) {
+    renderEffect("beer", iterations);
+}
+
+// A whole Matrix::loop(): effect, crossfade when there is one, and show()
+BENCHMARK(matrix, loop) {
+    Matrix &m = startMatrix();
+    for (uint32_t i = 0; i < iterations; i++) {
+        hostAdvance(8000);
+        m.loop(halMillis());
+        m.wait();
+    }
+}
+
+// show() with nothing changed is a compare; with a pixel changed, an encode and a transfer
+BENCHMARK(show, unchanged) {
+    Matrix &m = startMatrix();
+    m.show();
+    for (uint32_t i = 0; i < iterations; i++) {
+        m.show();
+    }
+}
+
+BENCHMARK(show, changed) {
+    Matrix &m = startMatrix();
+    for (uint32_t i = 0; i < iterations; i++) {
+        m.setPixelRGB(0, 0, i);
+        m.show();
+        m.wait();
+    }
+}
+
+BENCHMARK(strip, loop) {
+    static bool started = false;
+    if (!started) {
+        strip.initialize(visualizer, startMatrix());
+        started = true;
+    }
+
+    for (uint32_t i = 0; i < iterations; i++) {
+        hostAdvance(8000);
+        strip.loop(halMillis());
+        strip.wait();
+    }
+}
+
+// What calculateBeat() does with a new onset; without one it only dims
+BENCHMARK(beat, scoreOnset) {
+    uint8_t brightness = 0;
+    for (uint32_t i = 0; i < iterations; i++) {
+        brightness ^= strip.scoreOnset(1.0f + (i % 7) * 0.25f);
+    }
+    benchmarkKeep(&brightness);
+}
+
+BENCHMARK(color, lerpColor) {
+    uint32_t color = 0;
+    for (uint32_t i = 0; i < iterations; i++) {
+        color ^= lerpColor(0xFF8000, color | 0x0080FF, (uint8_t)i);
+    }
+    benchmarkKeep(&color);
+}
+
+// The colour wheel of old, as the strip samples it: one colour a call...
+BENCHMARK(color, sampleGradient) {
+    uint32_t color = 0;
+    for (uint32_t i = 0; i < iterations; i++) {
+        color ^= sampleGradient(rainbowGradient, (uint16_t)(i * 3));
+    }
+    benchmarkKeep(&color);
+}
+
+// ...or a strip's worth in one, per colour
+BENCHMARK(color, sampleGradient16) {
+    uint32_t colors[LED_STRIP_PIXELS];
+    for (uint32_t i = 0; i < iterations; i += LED_STRIP_PIXELS) {
+        sampleGradient(rainbowGradient, (uint16_t)(i * 3), 3, colors, LED_STRIP_PIXELS);
+        benchmarkKeep(colors);
+    }
+}
+
+// ...or out of the rainbow table, as the strip does now
+BENCHMARK(color, rainbowTable16) {
+    uint32_t colors[LED_STRIP_PIXELS];
+    for (uint32_t i = 0; i < iterations; i += LED_STRIP_PIXELS) {
+        for (uint8_t p = 0; p < LED_STRIP_PIXELS; p++) {
+            colors[p] = rainbowColor(i + p);
+        }
+        benchmarkKeep(colors);
+    }
+}
+
+// A table colour at a level, as the strip's level modes draw it
+BENCHMARK(color, scaleColor) {
+    uint32_t color = 0;
+    for (uint32_t i = 0; i < iterations; i++) {
+        color ^= scaleColor(rainbowColor(i), (uint8_t)(i >> 8));
+    }
+    benchmarkKeep(&color);
+}
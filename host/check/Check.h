@@ -0,0 +1,17 @@
+#ifndef _CHECK_H_
+#define _CHECK_H_
+
+/**
+ *  goggles-check: what the simulator models but cannot see go wrong by
+ *  itself. Each check prints a line per case and counts what fails in
+ *  checkFailures; main.cpp runs them all and exits non-zero on a failure.
+ *
+ *      make -C host check
+ */
+
+extern int checkFailures;
+
+void checkSpectrum();       // fft.cpp
+void checkPixelOutput();    // pixels.cpp
+
+#endif
@@ -0,0 +1,138 @@
+/**
+ *  Checks the Q15 spectrum path against a double precision DFT, through the
+ *  arm_rfft_q15 shim, which halves at every stage like CMSIS does: that the
+ *  output is X[k] / N, that nothing wraps or saturates at full scale, and how
+ *  far rounding takes a quiet tone, next to what arm_cmplx_mag_q15 makes of
+ *  it.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "Check.h"
+#include "constants.h"
+#include "FixedPoint.h"
+
+#define MAXIMUM_SIZE    BASS_FFT_SAMPLES
+
+static void expect(bool condition, const char *what, int size, const char *input, double value) {
+    if (!condition) {
+        printf("FAIL  %4d  %-22s %s (%.2f)\n", size, input, what, value);
+        checkFailures++;
+    }
+}
+
+// |X[k]| / N for k < N / 2, straight from the definition
+static void reference(const q15_t *samples, int size, double *magnitudes) {
+    for (int k = 0; k < size / 2; k++) {
+        double re = 0;
+        double im = 0;
+        for (int n = 0; n < size; n++) {
+            re += samples[n] * cos(2 * M_PI * k * n / size);
+            im -= samples[n] * sin(2 * M_PI * k * n / size);
+        }
+        magnitudes[k] = sqrt(re * re + im * im) / size;
+    }
+}
+
+/**
+ * Run one input through the Q15 path and compare every bin with the
+ * reference. Errors are in steps of the Q15 X[k] / N. Each stage truncates
+ * its two halved inputs and its twiddle product, up to two steps, and the
+ * later stages carry that along rather than halving it away, so the
+ * tolerance grows with the stages.
+ */
+static void check(const char *input, const q15_t *samples, int size) {
+    static q15_t work[MAXIMUM_SIZE];
+    static q15_t spectrum[MAXIMUM_SIZE * 2];
+    static q15_t magnitudes[MAXIMUM_SIZE / 2];
+    static q15_t cmsisMagnitudes[MAXIMUM_SIZE / 2];
+    static double expected[MAXIMUM_SIZE / 2];
+
+    arm_rfft_instance_q15 rfft;
+    arm_rfft_init_q15(&rfft, size, 0, 1);
+    memcpy(work, samples, size * sizeof(q15_t));
+    arm_rfft_q15(&rfft, work, spectrum);
+    complexMagnitudes(spectrum, magnitudes, size / 2);
+    arm_cmplx_mag_q15(spectrum, cmsisMagnitudes, size / 2);
+    reference(samples, size, expected);
+
+    int stages = 0;
+    while ((1 << stages) < size) {
+        stages++;
+    }
+    double tolerance = 2 * stages + 2;
+
+    double worst = 0;
+    double squares = 0;
+    int saturated = 0;
+    int peak = 0;
+    for (int k = 0; k < size / 2; k++) {
+        double error = 2 * magnitudes[k] - expected[k];
+        worst = fmax(worst, fabs(error));
+        squares += error * error;
+        if (spectrum[2 * k] == 32767 || spectrum[2 * k] == -32768 ||
+            spectrum[2 * k + 1] == 32767 || spectrum[2 * k + 1] == -32768) {
+            saturated++;
+        }
+        if (expected[k] > expected[peak]) {
+            peak = k;
+        }
+    }
+
+    printf("      %4d  %-22s peak %8.1f  got %8d  worst %5.2f  rms %5.2f  CMSIS magnitude %d\n",
+           size, input, expected[peak], 2 * magnitudes[peak], worst, sqrt(squares / (size / 2)),
+           2 * cmsisMagnitudes[peak]);
+    expect(worst <= tolerance, "error over tolerance", size, input, worst);
+    expect(saturated == 0 || expected[peak] >= 32767 - tolerance, "saturated", size, input, saturated);
+}
+
+static void tone(q15_t *samples, int size, double bin, double level) {
+    for (int n = 0; n < size; n++) {
+        samples[n] = saturateQ15((int32_t)lround(32767 * level * cos(2 * M_PI * bin * n / size)));
+    }
+}
+
+static void checkSize(int size) {
+    static q15_t samples[MAXIMUM_SIZE];
+    char input[32];
+
+    // Full scale tones land at half scale, on a bin and between two
+    static const double levels[] = { 1.0, 0.1, 0.01, 0.001 };
+    for (unsigned l = 0; l < sizeof(levels) / sizeof(levels[0]); l++) {
+        tone(samples, size, size / 8, levels[l]);
+        snprintf(input, sizeof(input), "tone %.0f dB", 20 * log10(levels[l]));
+        check(input, samples, size);
+    }
+    tone(samples, size, size / 8 + 0.5, 1.0);
+    check("tone 0 dB, off bin", samples, size);
+
+    // Worst cases: everything in one bin at full scale
+    for (int n = 0; n < size; n++) {
+        samples[n] = 32767;
+    }
+    check("DC full scale", samples, size);
+    for (int n = 0; n < size; n++) {
+        samples[n] = -32768;
+    }
+    check("DC negative full scale", samples, size);
+    tone(samples, size, size / 2 - 1, 1.0);
+    check("top bin full scale", samples, size);
+
+    // Full scale noise spreads over every bin
+    uint32_t state = 12345;
+    for (int n = 0; n < size; n++) {
+        state = state * 1664525 + 1013904223;
+        samples[n] = (q15_t)((state >> 16) - 32768);
+    }
+    check("noise full scale", samples, size);
+}
+
+void checkSpectrum() {
+    printf("      size  input                  |X|/N in Q15 steps; errors in steps\n");
+    checkSize(FFT_SAMPLES);
+    if (BASS_FFT_SAMPLES != FFT_SAMPLES) {
+        checkSize(BASS_FFT_SAMPLES);
+    }
+}
@@ -0,0 +1,18 @@
+#include <stdio.h>
+
+#include "Check.h"
+
+int checkFailures = 0;
+
+int main() {
+    checkSpectrum();
+    printf("\n");
+    checkPixelOutput();
+
+    if (checkFailures > 0) {
+        printf("%d failed\n", checkFailures);
+        return 1;
+    }
+    printf("all passed\n");
+    return 0;
+}
@@ -0,0 +1,75 @@
+/**
+ *  Checks which pixel transport each display gets and what a frame costs the
+ *  loop, through the host's model of the SAMD21 pin table. The goggles' own
+ *  pins are on no SERCOM pair (Hal.h), so both displays are expected to be
+ *  bit-banged, submit() holding the caller up for the whole frame, and the
+ *  two together to fit in a sample block. The SPI pairs are checked to return
+ *  straight away and stay busy until wait().
+ */
+
+#include <stdio.h>
+
+#include "Check.h"
+#include "DotStarOutput.h"
+#include "Hal.h"
+#include "HalHost.h"
+#include "Matrix.h"
+#include "Strip.h"
+
+#define MATRIX_PIXELS   (MATRIX_SIZE * 2 * MATRIX_SIZE)
+
+static uint64_t bitBangMicros(uint16_t pixels) {
+    return ((uint64_t)DOTSTAR_FRAME_BYTES(pixels) * 8 * 1000000 + PIXEL_BITBANG_CLOCK - 1) / PIXEL_BITBANG_CLOCK;
+}
+
+/**
+ * Send one frame of `pixels` on a pair and return how long it held up the
+ * caller in virtual time, failing unless the transport behaves as `blocking`
+ * says
+ */
+static uint64_t checkTransport(const char *display, uint8_t dataPin, uint8_t clockPin, uint16_t pixels,
+                               bool blocking) {
+    static uint8_t frame[DOTSTAR_FRAME_BYTES(MATRIX_PIXELS)];
+
+    PixelTransport *transport = halPixelTransport(dataPin, clockPin);
+    uint64_t start = hostNow();
+    transport->submit(frame, DOTSTAR_FRAME_BYTES(pixels));
+    uint64_t held = hostNow() - start;
+    bool busy = transport->busy();
+    transport->wait();
+    bool done = !transport->busy();
+    delete transport;
+
+    char pins[16];
+    snprintf(pins, sizeof(pins), "D%u/D%u", dataPin, clockPin);
+    printf("      %-8s %-8s %-11s held %5u us%s\n", display, pins, held > 0 ? "bit-banged" : "SPI + DMA",
+           (unsigned)held, busy ? ", busy until wait()" : "");
+
+    bool passed = blocking ? held == bitBangMicros(pixels) && !busy : held == 0 && busy && done;
+    if (!passed) {
+        printf("FAIL  %-8s %-8s expected %s\n", display, pins,
+               blocking ? "to block for the frame" : "to return at once and stay busy until wait()");
+        checkFailures++;
+    }
+    return held;
+}
+
+void checkPixelOutput() {
+    printf("      display  pins     transport\n");
+
+    // As wired: moving a display onto a SPI pair changes these along with Hal.h
+    uint64_t held = checkTransport("matrix", MATRIX_DATA_PIN, MATRIX_CLOCK_PIN, MATRIX_PIXELS, true);
+    held += checkTransport("strip", LED_STRIP_DATA_PIN, LED_STRIP_CLOCK_PIN, LED_STRIP_PIXELS, true);
+
+    // Where they would have to go for background output
+    checkTransport("matrix", 11, 12, MATRIX_PIXELS, false);
+    checkTransport("strip", PIN_SPI_MOSI, PIN_SPI_SCK, LED_STRIP_PIXELS, false);
+
+    // goggles.ino asserts the same, from the frame lengths
+    uint64_t block = (uint64_t)SAMPLE_BLOCK * 1000000 / SAMPLE_RATE;
+    printf("      both displays hold the loop %u us of a %u us sample block\n", (unsigned)held, (unsigned)block);
+    if (held >= block) {
+        printf("FAIL  bit-banged frames outlast a sample block, blocks would be dropped\n");
+        checkFailures++;
+    }
+}
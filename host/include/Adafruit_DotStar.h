@@ -0,0 +1,57 @@
+#ifndef _HOST_ADAFRUIT_DOTSTAR_H_
+#define _HOST_ADAFRUIT_DOTSTAR_H_
+
+/******************************************************************************
+
+Host stand-in for Adafruit_DotStar
+
+Same public API as the library, but only the pixel buffer: show() does
+nothing, the firmware sends frames through DotStarOutput and a PixelTransport
+(see Hal.h).
+
+******************************************************************************/
+
+#include <Arduino.h>
+
+// Color-order argument for constructor, same encoding as the library
+#define DOTSTAR_RGB (0 | (1 << 2) | (2 << 4))
+#define DOTSTAR_RBG (0 | (2 << 2) | (1 << 4))
+#define DOTSTAR_GRB (1 | (0 << 2) | (2 << 4))
+#define DOTSTAR_GBR (2 | (0 << 2) | (1 << 4))
+#define DOTSTAR_BRG (1 | (2 << 2) | (0 << 4))
+#define DOTSTAR_BGR (2 | (1 << 2) | (0 << 4))
+#define DOTSTAR_MONO 0
+
+class Adafruit_DotStar {
+public:
+    Adafruit_DotStar(uint16_t n, uint8_t o = DOTSTAR_BRG);
+    Adafruit_DotStar(uint16_t n, uint8_t d, uint8_t c, uint8_t o = DOTSTAR_BRG);
+    ~Adafruit_DotStar();
+
+    void begin();
+    void show();
+    void setPixelColor(uint16_t n, uint32_t c);
+    void setPixelColor(uint16_t n, uint8_t r, uint8_t g, uint8_t b);
+    void setBrightness(uint8_t b);
+    void clear();
+
+    uint8_t getBrightness() const;
+    uint8_t *getPixels() const;
+    uint16_t numPixels() const;
+    uint32_t getPixelColor(uint16_t n) const;
+    uint8_t getDataPin() const;
+
+    static uint32_t Color(uint8_t r, uint8_t g, uint8_t b);
+
+private:
+    uint16_t numLEDs;
+    uint8_t dataPin;
+    uint8_t clockPin;
+    uint8_t brightness;
+    uint8_t *pixels;
+    uint8_t rOffset;
+    uint8_t gOffset;
+    uint8_t bOffset;
+};
+
+#endif
@@ -0,0 +1,55 @@
+#ifndef _HOST_ADAFRUIT_GFX_H_
+#define _HOST_ADAFRUIT_GFX_H_
+
+/******************************************************************************
+
+Host stand-in for Adafruit_GFX
+
+The drawing primitives the goggles use, rasterised the same way as the
+library (classic 5x7 font in a 6x8 cell, text size 1). Only the glyphs the
+firmware prints are defined; anything else is drawn as an empty box.
+
+******************************************************************************/
+
+#include <Arduino.h>
+
+class Adafruit_GFX : public Print {
+public:
+    Adafruit_GFX(int16_t w, int16_t h);
+
+    virtual void drawPixel(int16_t x, int16_t y, uint16_t color) = 0;
+    virtual void fillScreen(uint16_t color);
+    virtual void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
+    virtual void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+    virtual void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+    virtual void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color);
+
+    void drawXBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h, uint16_t color);
+    void drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t bg, uint8_t size);
+
+    void setCursor(int16_t x, int16_t y);
+    void setTextColor(uint16_t c);
+    void setTextColor(uint16_t c, uint16_t bg);
+    void setTextSize(uint8_t s);
+    void setTextWrap(bool w);
+
+    int16_t width() const;
+    int16_t height() const;
+    int16_t getCursorX() const;
+    int16_t getCursorY() const;
+
+    virtual size_t write(uint8_t c);
+    using Print::write;
+
+protected:
+    int16_t _width;
+    int16_t _height;
+    int16_t cursor_x;
+    int16_t cursor_y;
+    uint16_t textcolor;
+    uint16_t textbgcolor;
+    uint8_t textsize;
+    bool wrap;
+};
+
+#endif
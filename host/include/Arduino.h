@@ -0,0 +1,95 @@
+#ifndef _HOST_ARDUINO_H_
+#define _HOST_ARDUINO_H_
+
+/******************************************************************************
+
+Host stand-in for the Arduino core
+
+Only the parts of the API the goggles firmware and the host shims use. Time
+and randomness come from the host HAL (host/HalHost.cpp) so a simulation run
+is deterministic.
+
+******************************************************************************/
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#ifndef PI
+#define PI 3.1415926535897932384626433832795
+#endif
+
+#define PROGMEM
+#define pgm_read_byte(address)  (*(const uint8_t *)(address))
+#define pgm_read_word(address)  (*(const uint16_t *)(address))
+#define pgm_read_dword(address) (*(const uint32_t *)(address))
+#define pgm_read_pointer(address) (*(address))
+
+// Feather M0 variant pins
+#define PIN_SPI_MOSI    23
+#define PIN_SPI_SCK     24
+
+class __FlashStringHelper;
+#define F(string) (reinterpret_cast<const __FlashStringHelper *>(string))
+
+#ifndef min
+#define min(a, b) ((a) < (b) ? (a) : (b))
+#endif
+#ifndef max
+#define max(a, b) ((a) > (b) ? (a) : (b))
+#endif
+#ifndef abs
+#define abs(x) ((x) > 0 ? (x) : -(x))
+#endif
+#ifndef constrain
+#define constrain(amount, low, high) ((amount) < (low) ? (low) : ((amount) > (high) ? (high) : (amount)))
+#endif
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+long random(long howbig);
+long random(long howsmall, long howbig);
+void randomSeed(unsigned long seed);
+
+class Print {
+public:
+    virtual ~Print() {}
+
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t *buffer, size_t size);
+
+    size_t write(const char *str);
+    size_t print(const __FlashStringHelper *str);
+    size_t print(const char *str);
+    size_t print(char c);
+    size_t print(int value);
+    size_t print(unsigned int value);
+    size_t print(long value);
+    size_t print(unsigned long value);
+    size_t print(double value, int digits = 2);
+    size_t println();
+    size_t println(const char *str);
+};
+
+class HostSerial : public Print {
+public:
+    void begin(unsigned long baud);
+    int available();
+    int read();
+    int availableForWrite();
+    void flush();
+    size_t write(uint8_t c);
+    using Print::write;
+
+    operator bool() { return true; }
+};
+
+extern HostSerial Serial;
+
+#endif
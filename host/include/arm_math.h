@@ -0,0 +1,57 @@
+#ifndef _HOST_ARM_MATH_H_
+#define _HOST_ARM_MATH_H_
+
+/******************************************************************************
+
+Host stand-in for CMSIS-DSP arm_math.h
+
+Portable C implementations of the CMSIS functions the firmware calls, with the
+same signatures and output layout, so analysis results match the device.
+
+******************************************************************************/
+
+#include <math.h>
+#include <stdint.h>
+
+typedef float float32_t;
+typedef double float64_t;
+typedef int8_t q7_t;
+typedef int16_t q15_t;
+typedef int32_t q31_t;
+typedef int64_t q63_t;
+
+#ifndef PI
+#define PI 3.14159265358979f
+#endif
+
+typedef enum {
+    ARM_MATH_SUCCESS = 0,
+    ARM_MATH_ARGUMENT_ERROR = -1,
+    ARM_MATH_LENGTH_ERROR = -2,
+    ARM_MATH_SIZE_MISMATCH = -3,
+    ARM_MATH_NANINF = -4,
+    ARM_MATH_SINGULAR = -5,
+    ARM_MATH_TEST_FAILURE = -6
+} arm_status;
+
+typedef struct {
+    uint16_t fftLen;
+} arm_cfft_instance_f32;
+
+typedef struct {
+    uint32_t fftLenReal;
+    uint8_t ifftFlagR;
+    uint8_t bitReverseFlagR;
+} arm_rfft_instance_q15;
+
+void arm_cfft_f32(const arm_cfft_instance_f32 *S, float32_t *p1, uint8_t ifftFlag, uint8_t bitReverseFlag);
+arm_status arm_rfft_init_q15(arm_rfft_instance_q15 *S, uint32_t fftLenReal, uint32_t ifftFlagR, uint32_t bitReverseFlag);
+void arm_rfft_q15(const arm_rfft_instance_q15 *S, q15_t *pSrc, q15_t *pDst);
+void arm_cmplx_mag_q15(const q15_t *pSrc, q15_t *pDst, uint32_t numSamples);
+void arm_cmplx_mag_f32(const float32_t *pSrc, float32_t *pDst, uint32_t numSamples);
+void arm_max_f32(const float32_t *pSrc, uint32_t blockSize, float32_t *pResult, uint32_t *pIndex);
+void arm_mean_f32(const float32_t *pSrc, uint32_t blockSize, float32_t *pResult);
+float32_t arm_cos_f32(float32_t x);
+float32_t arm_sin_f32(float32_t x);
+
+#endif
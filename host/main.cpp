@@ -0,0 +1,385 @@
+/******************************************************************************
+
+GOGGLES V2 - native simulation
+
+Runs the unmodified firmware (goggles.ino) against the host HAL: virtual time,
+synthetic or WAV audio, and a virtual 16 pixel strip and 16x8 matrix.
+
+    goggles-sim [options]
+
+        --input FILE      16-bit PCM WAV to play instead of the test pattern
+        --seconds N       Virtual time to simulate (default 10, or the file)
+        --tick-us N       Virtual time per loop() iteration (default 250)
+        --seed N          Random seed (default 1)
+        --render          Draw the matrix and strip in the terminal
+        --pixels FILE     Record every transfer (see writePixels for the format)
+        --serial FILE     Where Serial output goes (default discarded)
+        --telemetry N     Telemetry reports per second (see Telemetry.h),
+                          decode the --serial file with tools/telemetry.py
+        --report FILE     Write the results below, every onset and a digest
+                          of each pixel stream as JSON (tools/replay.py)
+
+At the end the wall-clock cost of loop(), of each scheduler task and of each
+profiled stage (Profile.h) is reported, which is what to watch for
+regressions and hot spots.
+
+******************************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+#include "HalHost.h"
+#include "Matrix.h"
+#include "Profile.h"
+#include "Scheduler.h"
+#include "Strip.h"
+#include "Telemetry.h"
+
+void setup();
+void loop();
+
+extern Visualizer visualizer;
+extern Scheduler scheduler;
+extern Matrix matrix;
+extern Strip strip;
+extern Telemetry telemetry;
+
+struct Output {
+    uint32_t shows;
+    uint64_t bytes;
+    uint64_t digest;
+};
+
+struct Onset {
+    uint32_t time;
+    float32_t strength;
+    uint8_t bands;
+};
+
+// Profile.h stage order
+static const char *stageNames[PROFILE_STAGES] = { "capture", "fft", "render", "show", "spectrum" };
+// Stages are timed in CPU cycles; the host's are its own clock scaled, so
+// they are reported in us
+#define CYCLES_PER_MICRO (HAL_CPU_CLOCK / 1000000.0)
+
+struct Simulation {
+    Output matrix;
+    Output strip;
+    FILE *pixels;
+    bool render;
+    uint64_t lastRender;
+    uint8_t stripFrame[LED_STRIP_PIXELS * 4];
+};
+
+static void usage(const char *name) {
+    fprintf(stderr,
+            "usage: %s [--input FILE] [--seconds N] [--tick-us N] [--seed N]\n"
+            "          [--render] [--pixels FILE] [--serial FILE] [--telemetry N]\n"
+            "          [--report FILE]\n", name);
+}
+
+#define FNV_OFFSET  0xcbf29ce484222325ull
+#define FNV_PRIME   0x100000001b3ull
+
+// FNV-1a, so two runs can be compared without keeping their pixels
+static uint64_t digest(uint64_t hash, const uint8_t *data, uint16_t length) {
+    for (uint16_t i = 0; i < length; i++) {
+        hash = (hash ^ data[i]) * FNV_PRIME;
+    }
+
+    return hash;
+}
+
+// Wire frames start with 4 zero bytes, then 0xFF, blue, green, red per pixel
+#define FRAME_START_BYTES   4
+
+static const uint8_t* framePixel(const uint8_t *frame, uint16_t index) {
+    return frame + FRAME_START_BYTES + index * 4;
+}
+
+/**
+ * One record per transfer:
+ *   uint64 virtual time (us), uint8 data pin, uint16 frame length,
+ *   then the frame bytes exactly as clocked out.
+ * All little endian.
+ */
+static void writePixels(FILE *file, uint8_t dataPin, const uint8_t *frame, uint16_t length) {
+    uint8_t header[11];
+    uint64_t time = hostNow();
+
+    for (uint8_t i = 0; i < 8; i++) {
+        header[i] = (uint8_t)(time >> (8 * i));
+    }
+    header[8] = dataPin;
+    header[9] = (uint8_t)length;
+    header[10] = (uint8_t)(length >> 8);
+    fwrite(header, 1, sizeof(header), file);
+    fwrite(frame, 1, length, file);
+}
+
+static void renderPixel(const uint8_t *pixel) {
+    printf("\x1b[38;2;%d;%d;%dm██", pixel[3], pixel[2], pixel[1]);
+}
+
+static void render(Simulation *simulation, const uint8_t *frame) {
+    printf("\x1b[H");
+    for (int16_t y = 0; y < MATRIX_SIZE; y++) {
+        for (int16_t x = 0; x < MATRIX_SIZE * 2; x++) {
+            renderPixel(framePixel(frame, Matrix::pixelIndex(x, y)));
+        }
+        printf("\x1b[0m\n");
+    }
+
+    printf("\n");
+    for (uint8_t i = 0; i < LED_STRIP_PIXELS; i++) {
+        renderPixel(simulation->stripFrame + i * 4);
+    }
+    printf("\x1b[0m\n%10.3f s\n", hostNow() / 1000000.0);
+    fflush(stdout);
+}
+
+static void pixelSink(uint8_t dataPin, const uint8_t *frame, uint16_t length, void *context) {
+    Simulation *simulation = (Simulation *)context;
+    bool isMatrix = dataPin == MATRIX_DATA_PIN;
+    Output *output = isMatrix ? &simulation->matrix : &simulation->strip;
+
+    output->shows++;
+    output->bytes += length;
+    output->digest = digest(output->digest, frame, length);
+
+    if (simulation->pixels != NULL) {
+        writePixels(simulation->pixels, dataPin, frame, length);
+    }
+
+    if (!isMatrix) {
+        memcpy(simulation->stripFrame, framePixel(frame, 0), sizeof(simulation->stripFrame));
+    } else if (simulation->render && hostNow() - simulation->lastRender >= 50000) {
+        simulation->lastRender = hostNow();
+        render(simulation, frame);
+    }
+}
+
+static double percentile(std::vector<double> &values, double fraction) {
+    if (values.empty()) {
+        return 0;
+    }
+
+    size_t index = (size_t)(fraction * (values.size() - 1));
+    std::nth_element(values.begin(), values.begin() + index, values.end());
+    return values[index];
+}
+
+static void reportOutput(FILE *file, const char *name, const Output &output, bool last) {
+    fprintf(file, "  \"%s\": {\"shows\": %u, \"bytes\": %llu, \"digest\": \"%016llx\"}%s\n", name,
+            output.shows, (unsigned long long)output.bytes, (unsigned long long)output.digest, last ? "" : ",");
+}
+
+/**
+ * Everything tools/replay.py compares against its baselines
+ */
+static bool writeReport(const char *path, const char *input, double simulated, const Simulation &simulation,
+                        const std::vector<Onset> &onsets, const std::vector<double> &loopTimes) {
+    FILE *file = fopen(path, "w");
+    if (file == NULL) {
+        return false;
+    }
+
+    double total = 0;
+    for (size_t i = 0; i < loopTimes.size(); i++) {
+        total += loopTimes[i];
+    }
+
+    fprintf(file, "{\n");
+    fprintf(file, "  \"input\": \"%s\",\n", input != NULL ? input : "synthetic");
+    fprintf(file, "  \"seconds\": %.6f,\n", simulated);
+    fprintf(file, "  \"blocks\": %u,\n", hostSampleBlocks());
+    fprintf(file, "  \"overruns\": %u,\n", halSampleOverruns());
+    fprintf(file, "  \"loop_us\": %.4f,\n", loopTimes.empty() ? 0 : total / loopTimes.size());
+
+    fprintf(file, "  \"stages\": {\n");
+    for (uint8_t i = 0; i < PROFILE_STAGES; i++) {
+        const ProfileStage &stage = profileStage(i);
+        double mean = stage.count > 0 ? (double)stage.totalCycles / stage.count : 0.0;
+        fprintf(file, "    \"%s\": {\"count\": %u, \"mean_us\": %.4f, \"worst_us\": %.0f}%s\n", stageNames[i],
+                stage.count, mean / CYCLES_PER_MICRO, stage.worstCycles / CYCLES_PER_MICRO,
+                i + 1 < PROFILE_STAGES ? "," : "");
+    }
+    fprintf(file, "  },\n");
+
+    fprintf(file, "  \"tasks\": {\n");
+    for (uint8_t i = 0; i < scheduler.getTaskCount(); i++) {
+        const SchedulerStats &task = scheduler.getStats(i);
+        fprintf(file, "    \"%s\": {\"runs\": %u, \"mean_us\": %.4f, \"worst_us\": %u, \"missed\": %u}%s\n",
+                task.name, task.runs, task.runs > 0 ? (double)task.totalTime / task.runs : 0.0, task.worstTime,
+                task.missed, i + 1 < scheduler.getTaskCount() ? "," : "");
+    }
+    fprintf(file, "  },\n");
+
+    reportOutput(file, "matrix", simulation.matrix, false);
+    reportOutput(file, "strip", simulation.strip, false);
+
+    fprintf(file, "  \"onsets\": [");
+    for (size_t i = 0; i < onsets.size(); i++) {
+        fprintf(file, "%s\n    [%u, %.4f, %u]", i > 0 ? "," : "", onsets[i].time, onsets[i].strength,
+                onsets[i].bands);
+    }
+    fprintf(file, "%s]\n}\n", onsets.empty() ? "" : "\n  ");
+
+    return fclose(file) == 0;
+}
+
+int main(int argc, char **argv) {
+    const char *input = NULL;
+    double seconds = 0;
+    uint32_t tick = 250;
+    uint32_t seed = 1;
+    int telemetryRate = -1;
+    const char *report = NULL;
+    Simulation simulation = {};
+    simulation.matrix.digest = FNV_OFFSET;
+    simulation.strip.digest = FNV_OFFSET;
+
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--input") == 0 && hasValue) {
+            input = argv[++i];
+        } else if (strcmp(argv[i], "--seconds") == 0 && hasValue) {
+            seconds = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--tick-us") == 0 && hasValue) {
+            tick = atoi(argv[++i]);
+            if (tick == 0) {
+                tick = 1;
+            }
+        } else if (strcmp(argv[i], "--seed") == 0 && hasValue) {
+            seed = strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--telemetry") == 0 && hasValue) {
+            telemetryRate = atoi(argv[++i]);
+            telemetryRate = constrain(telemetryRate, 0, 255);
+        } else if (strcmp(argv[i], "--report") == 0 && hasValue) {
+            report = argv[++i];
+        } else if (strcmp(argv[i], "--render") == 0) {
+            simulation.render = true;
+        } else if (strcmp(argv[i], "--pixels") == 0 && hasValue) {
+            simulation.pixels = fopen(argv[++i], "wb");
+            if (simulation.pixels == NULL) {
+                perror(argv[i]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--serial") == 0 && hasValue) {
+            FILE *serial = fopen(argv[++i], "wb");
+            if (serial == NULL) {
+                perror(argv[i]);
+                return 1;
+            }
+            hostSetSerialOutput(serial);
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (input != NULL) {
+        if (!hostAudioOpen(input)) {
+            fprintf(stderr, "%s: not a 16-bit PCM WAV file\n", input);
+            return 1;
+        }
+    } else {
+        hostAudioSynthetic();
+        if (seconds <= 0) {
+            seconds = 10;
+        }
+    }
+
+    hostRandomSeed(seed);
+    hostSetPixelSink(pixelSink, &simulation);
+    if (simulation.render) {
+        printf("\x1b[2J");
+    }
+
+    setup();
+    if (telemetryRate >= 0) {
+        telemetry.setRate(telemetryRate);
+    }
+
+    std::vector<double> loopTimes;
+    std::vector<Onset> onsets;
+    uint32_t lastOnset = visualizer.getFrame().onsetTime;
+    uint64_t end = (uint64_t)(seconds * 1000000);
+    while ((seconds <= 0 || hostNow() < end) && !hostAudioFinished()) {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        loop();
+        std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+
+        loopTimes.push_back(elapsed.count());
+        const Visualizer::Frame &frame = visualizer.getFrame();
+        if (frame.onsetTime != lastOnset) {
+            lastOnset = frame.onsetTime;
+            Onset onset = { frame.onsetTime, frame.onsetStrength, frame.onsetBands };
+            onsets.push_back(onset);
+        }
+        hostAdvance(tick);
+    }
+
+    double simulated = hostNow() / 1000000.0;
+    double total = 0;
+    for (size_t i = 0; i < loopTimes.size(); i++) {
+        total += loopTimes[i];
+    }
+
+    fprintf(stderr, "simulated   %.3f s of %s audio\n", simulated, input != NULL ? input : "synthetic");
+    fprintf(stderr, "loops       %zu (tick %u us)\n", loopTimes.size(), tick);
+    fprintf(stderr, "analysis    %u blocks (%.1f/s, %u overruns)\n", hostSampleBlocks(),
+            hostSampleBlocks() / simulated, halSampleOverruns());
+    fprintf(stderr, "onsets      %zu (%.1f/min)\n", onsets.size(), onsets.size() * 60 / simulated);
+    fprintf(stderr, "bass        %u frames (%.1f/s), last peak %.1f Hz\n", visualizer.getFrame().bassSequence,
+            visualizer.getFrame().bassSequence / simulated, visualizer.getFrame().bassPeakFrequency / 16.0);
+    fprintf(stderr, "matrix      %u shows (%.1f/s, %llu bytes, %u unchanged skipped, %u waited)\n",
+            simulation.matrix.shows, simulation.matrix.shows / simulated,
+            (unsigned long long)simulation.matrix.bytes, matrix.getSkipped(), matrix.getWaits());
+    fprintf(stderr, "strip       %u shows (%.1f/s, %llu bytes, %u unchanged skipped, %u waited)\n",
+            simulation.strip.shows, simulation.strip.shows / simulated,
+            (unsigned long long)simulation.strip.bytes, strip.getSkipped(), strip.getWaits());
+    fprintf(stderr, "loop() us   mean %.2f  p50 %.2f  p99 %.2f  max %.2f\n",
+            loopTimes.empty() ? 0 : total / loopTimes.size(),
+            percentile(loopTimes, 0.5), percentile(loopTimes, 0.99), percentile(loopTimes, 1.0));
+    for (uint8_t i = 0; i < scheduler.getTaskCount(); i++) {
+        const SchedulerStats &task = scheduler.getStats(i);
+        fprintf(stderr, "task %-10s %u runs, us mean %.2f  max %u, late max %u, %u missed, %u dropped\n",
+                task.name, task.runs, task.runs > 0 ? (double)task.totalTime / task.runs : 0.0, task.worstTime,
+                task.worstLateness, task.missed, task.dropped);
+    }
+
+    for (uint8_t i = 0; i < PROFILE_STAGES; i++) {
+        const ProfileStage &stage = profileStage(i);
+        double mean = stage.count > 0 ? (double)stage.totalCycles / stage.count : 0.0;
+        fprintf(stderr, "stage %-9s %u runs, us mean %.2f  max %.0f\n", stageNames[i], stage.count,
+                mean / CYCLES_PER_MICRO, stage.worstCycles / CYCLES_PER_MICRO);
+    }
+
+    // Virtual time stands still while tasks run, so on the host every tick is
+    // idle; the share that would be awake is the host's task time against it
+    double elapsed = scheduler.getElapsedTime();
+    if (elapsed > 0) {
+        double busy = 100 * scheduler.getBusyTime() / elapsed;
+        fprintf(stderr, "duty        %.1f%% tasks, %.1f%% idle (%.1f%% of ticks slept)\n",
+                busy, 100 - busy, 100 * scheduler.getIdleTime() / elapsed);
+    }
+    if (telemetry.getRate() > 0) {
+        fprintf(stderr, "telemetry   %u packets, %u dropped\n", telemetry.getPackets(), telemetry.getDropped());
+    }
+
+    if (report != NULL && !writeReport(report, input, simulated, simulation, onsets, loopTimes)) {
+        perror(report);
+        return 1;
+    }
+
+    if (simulation.pixels != NULL) {
+        fclose(simulation.pixels);
+    }
+    if (hostSerialOutput() != NULL) {
+        fclose(hostSerialOutput());
+    }
+
+    return 0;
+}
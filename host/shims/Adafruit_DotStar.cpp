@@ -0,0 +1,76 @@
+#include <Adafruit_DotStar.h>
+
+Adafruit_DotStar::Adafruit_DotStar(uint16_t n, uint8_t o)
+    : Adafruit_DotStar(n, 0xFF, 0xFF, o)
+{
+}
+
+Adafruit_DotStar::Adafruit_DotStar(uint16_t n, uint8_t d, uint8_t c, uint8_t o)
+    : numLEDs(n), dataPin(d), clockPin(c), brightness(0),
+      rOffset(o & 3), gOffset((o >> 2) & 3), bOffset((o >> 4) & 3)
+{
+    pixels = (uint8_t *)calloc(numLEDs * 3, 1);
+}
+
+Adafruit_DotStar::~Adafruit_DotStar() {
+    free(pixels);
+}
+
+void Adafruit_DotStar::begin() {
+}
+
+void Adafruit_DotStar::show() {
+}
+
+void Adafruit_DotStar::setPixelColor(uint16_t n, uint32_t c) {
+    if (n >= numLEDs) {
+        return;
+    }
+
+    uint8_t *p = &pixels[n * 3];
+    p[rOffset] = (uint8_t)(c >> 16);
+    p[gOffset] = (uint8_t)(c >> 8);
+    p[bOffset] = (uint8_t)c;
+}
+
+void Adafruit_DotStar::setPixelColor(uint16_t n, uint8_t r, uint8_t g, uint8_t b) {
+    setPixelColor(n, Color(r, g, b));
+}
+
+// Stored as +1 like the library, so 0 means "no scaling"
+void Adafruit_DotStar::setBrightness(uint8_t b) {
+    brightness = b + 1;
+}
+
+void Adafruit_DotStar::clear() {
+    memset(pixels, 0, numLEDs * 3);
+}
+
+uint8_t Adafruit_DotStar::getBrightness() const {
+    return brightness - 1;
+}
+
+uint8_t *Adafruit_DotStar::getPixels() const {
+    return pixels;
+}
+
+uint16_t Adafruit_DotStar::numPixels() const {
+    return numLEDs;
+}
+
+uint32_t Adafruit_DotStar::getPixelColor(uint16_t n) const {
+    if (n >= numLEDs) {
+        return 0;
+    }
+
+    const uint8_t *p = &pixels[n * 3];
+    return ((uint32_t)p[rOffset] << 16) | ((uint32_t)p[gOffset] << 8) | p[bOffset];
+}
+
+uint8_t Adafruit_DotStar::getDataPin() const {
+    return dataPin;
+}
+
+uint32_t Adafruit_DotStar::Color(uint8_t r, uint8_t g, uint8_t b) {
+    return ((uint32_t)r << 16) | ((uint32_t)g << 8) | b;
+}
@@ -0,0 +1,242 @@
+#include <Adafruit_GFX.h>
+
+// Classic 5x7 font, one byte per column, LSB at the top. Indexed by character
+// code; glyphs the firmware never prints are left blank.
+struct Glyph {
+    char c;
+    uint8_t columns[5];
+};
+
+static const Glyph glyphs[] = {
+    { ' ', { 0x00, 0x00, 0x00, 0x00, 0x00 } },
+    { '!', { 0x00, 0x00, 0x5F, 0x00, 0x00 } },
+    { '-', { 0x08, 0x08, 0x08, 0x08, 0x08 } },
+    { '.', { 0x00, 0x60, 0x60, 0x00, 0x00 } },
+    { ':', { 0x00, 0x36, 0x36, 0x00, 0x00 } },
+    { '0', { 0x3E, 0x51, 0x49, 0x45, 0x3E } },
+    { '1', { 0x00, 0x42, 0x7F, 0x40, 0x00 } },
+    { '2', { 0x42, 0x61, 0x51, 0x49, 0x46 } },
+    { '3', { 0x21, 0x41, 0x45, 0x4B, 0x31 } },
+    { '4', { 0x18, 0x14, 0x12, 0x7F, 0x10 } },
+    { '5', { 0x27, 0x45, 0x45, 0x45, 0x39 } },
+    { '6', { 0x3C, 0x4A, 0x49, 0x49, 0x30 } },
+    { '7', { 0x01, 0x71, 0x09, 0x05, 0x03 } },
+    { '8', { 0x36, 0x49, 0x49, 0x49, 0x36 } },
+    { '9', { 0x06, 0x49, 0x49, 0x29, 0x1E } },
+    { 'A', { 0x7C, 0x12, 0x11, 0x12, 0x7C } },
+    { 'B', { 0x7F, 0x49, 0x49, 0x49, 0x36 } },
+    { 'C', { 0x3E, 0x41, 0x41, 0x41, 0x22 } },
+    { 'D', { 0x7F, 0x41, 0x41, 0x22, 0x1C } },
+    { 'E', { 0x7F, 0x49, 0x49, 0x49, 0x41 } },
+    { 'F', { 0x7F, 0x09, 0x09, 0x09, 0x01 } },
+    { 'G', { 0x3E, 0x41, 0x49, 0x49, 0x7A } },
+    { 'H', { 0x7F, 0x08, 0x08, 0x08, 0x7F } },
+    { 'I', { 0x00, 0x41, 0x7F, 0x41, 0x00 } },
+    { 'J', { 0x20, 0x40, 0x41, 0x3F, 0x01 } },
+    { 'K', { 0x7F, 0x08, 0x14, 0x22, 0x41 } },
+    { 'L', { 0x7F, 0x40, 0x40, 0x40, 0x40 } },
+    { 'M', { 0x7F, 0x02, 0x0C, 0x02, 0x7F } },
+    { 'N', { 0x7F, 0x04, 0x08, 0x10, 0x7F } },
+    { 'O', { 0x3E, 0x41, 0x41, 0x41, 0x3E } },
+    { 'P', { 0x7F, 0x09, 0x09, 0x09, 0x06 } },
+    { 'Q', { 0x3E, 0x41, 0x51, 0x21, 0x5E } },
+    { 'R', { 0x7F, 0x09, 0x19, 0x29, 0x46 } },
+    { 'S', { 0x46, 0x49, 0x49, 0x49, 0x31 } },
+    { 'T', { 0x01, 0x01, 0x7F, 0x01, 0x01 } },
+    { 'U', { 0x3F, 0x40, 0x40, 0x40, 0x3F } },
+    { 'V', { 0x1F, 0x20, 0x40, 0x20, 0x1F } },
+    { 'W', { 0x3F, 0x40, 0x38, 0x40, 0x3F } },
+    { 'X', { 0x63, 0x14, 0x08, 0x14, 0x63 } },
+    { 'Y', { 0x07, 0x08, 0x70, 0x08, 0x07 } },
+    { 'Z', { 0x61, 0x51, 0x49, 0x45, 0x43 } }
+};
+
+static uint8_t glyphColumn(unsigned char c, uint8_t column) {
+    if (c >= 'a' && c <= 'z') {
+        c -= 'a' - 'A';
+    }
+
+    for (size_t i = 0; i < sizeof(glyphs) / sizeof(glyphs[0]); i++) {
+        if (glyphs[i].c == (char)c) {
+            return glyphs[i].columns[column];
+        }
+    }
+
+    // Unknown glyph, draw an empty box
+    return (column == 0 || column == 4) ? 0x7F : 0x41;
+}
+
+Adafruit_GFX::Adafruit_GFX(int16_t w, int16_t h)
+    : _width(w), _height(h), cursor_x(0), cursor_y(0),
+      textcolor(0xFFFF), textbgcolor(0xFFFF), textsize(1), wrap(true)
+{
+}
+
+void Adafruit_GFX::fillScreen(uint16_t color) {
+    fillRect(0, 0, _width, _height, color);
+}
+
+void Adafruit_GFX::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+    for (int16_t i = 0; i < h; i++) {
+        drawPixel(x, y + i, color);
+    }
+}
+
+void Adafruit_GFX::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+    for (int16_t i = 0; i < w; i++) {
+        drawPixel(x + i, y, color);
+    }
+}
+
+void Adafruit_GFX::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    for (int16_t i = x; i < x + w; i++) {
+        drawFastVLine(i, y, h, color);
+    }
+}
+
+void Adafruit_GFX::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
+    if (x0 == x1) {
+        if (y0 > y1) {
+            int16_t t = y0; y0 = y1; y1 = t;
+        }
+        drawFastVLine(x0, y0, y1 - y0 + 1, color);
+        return;
+    }
+
+    if (y0 == y1) {
+        if (x0 > x1) {
+            int16_t t = x0; x0 = x1; x1 = t;
+        }
+        drawFastHLine(x0, y0, x1 - x0 + 1, color);
+        return;
+    }
+
+    bool steep = abs(y1 - y0) > abs(x1 - x0);
+    int16_t t;
+    if (steep) {
+        t = x0; x0 = y0; y0 = t;
+        t = x1; x1 = y1; y1 = t;
+    }
+    if (x0 > x1) {
+        t = x0; x0 = x1; x1 = t;
+        t = y0; y0 = y1; y1 = t;
+    }
+
+    int16_t dx = x1 - x0;
+    int16_t dy = abs(y1 - y0);
+    int16_t err = dx / 2;
+    int16_t ystep = y0 < y1 ? 1 : -1;
+
+    for (; x0 <= x1; x0++) {
+        if (steep) {
+            drawPixel(y0, x0, color);
+        } else {
+            drawPixel(x0, y0, color);
+        }
+
+        err -= dy;
+        if (err < 0) {
+            y0 += ystep;
+            err += dx;
+        }
+    }
+}
+
+void Adafruit_GFX::drawXBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h, uint16_t color) {
+    int16_t byteWidth = (w + 7) / 8;
+    uint8_t bits = 0;
+
+    for (int16_t j = 0; j < h; j++) {
+        for (int16_t i = 0; i < w; i++) {
+            if (i & 7) {
+                bits >>= 1;
+            } else {
+                bits = pgm_read_byte(&bitmap[j * byteWidth + i / 8]);
+            }
+
+            if (bits & 0x01) {
+                drawPixel(x + i, y + j, color);
+            }
+        }
+    }
+}
+
+void Adafruit_GFX::drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t bg, uint8_t size) {
+    if (x >= _width || y >= _height || (x + 6 * size - 1) < 0 || (y + 8 * size - 1) < 0) {
+        return;
+    }
+
+    for (int8_t i = 0; i < 6; i++) {
+        uint8_t line = i < 5 ? glyphColumn(c, i) : 0;
+        for (int8_t j = 0; j < 8; j++, line >>= 1) {
+            if (line & 0x01) {
+                if (size == 1) {
+                    drawPixel(x + i, y + j, color);
+                } else {
+                    fillRect(x + i * size, y + j * size, size, size, color);
+                }
+            } else if (bg != color) {
+                if (size == 1) {
+                    drawPixel(x + i, y + j, bg);
+                } else {
+                    fillRect(x + i * size, y + j * size, size, size, bg);
+                }
+            }
+        }
+    }
+}
+
+void Adafruit_GFX::setCursor(int16_t x, int16_t y) {
+    cursor_x = x;
+    cursor_y = y;
+}
+
+void Adafruit_GFX::setTextColor(uint16_t c) {
+    textcolor = textbgcolor = c;
+}
+
+void Adafruit_GFX::setTextColor(uint16_t c, uint16_t bg) {
+    textcolor = c;
+    textbgcolor = bg;
+}
+
+void Adafruit_GFX::setTextSize(uint8_t s) {
+    textsize = s > 0 ? s : 1;
+}
+
+void Adafruit_GFX::setTextWrap(bool w) {
+    wrap = w;
+}
+
+int16_t Adafruit_GFX::width() const {
+    return _width;
+}
+
+int16_t Adafruit_GFX::height() const {
+    return _height;
+}
+
+int16_t Adafruit_GFX::getCursorX() const {
+    return cursor_x;
+}
+
+int16_t Adafruit_GFX::getCursorY() const {
+    return cursor_y;
+}
+
+size_t Adafruit_GFX::write(uint8_t c) {
+    if (c == '\n') {
+        cursor_x = 0;
+        cursor_y += textsize * 8;
+    } else if (c != '\r') {
+        if (wrap && (cursor_x + textsize * 6) > _width) {
+            cursor_x = 0;
+            cursor_y += textsize * 8;
+        }
+
+        drawChar(cursor_x, cursor_y, c, textcolor, textbgcolor, textsize);
+        cursor_x += textsize * 6;
+    }
+
+    return 1;
+}
@@ -0,0 +1,122 @@
+#include <Arduino.h>
+
+#include "Hal.h"
+#include "HalHost.h"
+
+HostSerial Serial;
+
+unsigned long millis() {
+    return halMillis();
+}
+
+unsigned long micros() {
+    return halMicros();
+}
+
+void delay(unsigned long ms) {
+    hostAdvance((uint64_t)ms * 1000);
+}
+
+long random(long howbig) {
+    return halRandom(howbig);
+}
+
+long random(long howsmall, long howbig) {
+    return halRandom(howsmall, howbig);
+}
+
+void randomSeed(unsigned long seed) {
+    hostRandomSeed(seed);
+}
+
+size_t Print::write(const uint8_t *buffer, size_t size) {
+    size_t n = 0;
+    while (size--) {
+        n += write(*buffer++);
+    }
+
+    return n;
+}
+
+size_t Print::write(const char *str) {
+    return str == NULL ? 0 : write((const uint8_t *)str, strlen(str));
+}
+
+size_t Print::print(const __FlashStringHelper *str) {
+    return write(reinterpret_cast<const char *>(str));
+}
+
+size_t Print::print(const char *str) {
+    return write(str);
+}
+
+size_t Print::print(char c) {
+    return write((uint8_t)c);
+}
+
+size_t Print::print(int value) {
+    return print((long)value);
+}
+
+size_t Print::print(unsigned int value) {
+    return print((unsigned long)value);
+}
+
+size_t Print::print(long value) {
+    char buffer[24];
+    snprintf(buffer, sizeof(buffer), "%ld", value);
+    return write(buffer);
+}
+
+size_t Print::print(unsigned long value) {
+    char buffer[24];
+    snprintf(buffer, sizeof(buffer), "%lu", value);
+    return write(buffer);
+}
+
+size_t Print::print(double value, int digits) {
+    char buffer[48];
+    snprintf(buffer, sizeof(buffer), "%.*f", digits, value);
+    return write(buffer);
+}
+
+size_t Print::println() {
+    return write("\r\n");
+}
+
+size_t Print::println(const char *str) {
+    return print(str) + println();
+}
+
+void HostSerial::begin(unsigned long baud) {
+    (void)baud;
+}
+
+int HostSerial::available() {
+    return 0;
+}
+
+int HostSerial::read() {
+    return -1;
+}
+
+// One USB full speed bulk packet, like the SAMD core's CDC
+int HostSerial::availableForWrite() {
+    return 63;
+}
+
+void HostSerial::flush() {
+    FILE *output = hostSerialOutput();
+    if (output != NULL) {
+        fflush(output);
+    }
+}
+
+size_t HostSerial::write(uint8_t c) {
+    FILE *output = hostSerialOutput();
+    if (output != NULL) {
+        fputc(c, output);
+    }
+
+    return 1;
+}
@@ -0,0 +1,209 @@
+#include <arm_math.h>
+#include <arm_const_structs.h>
+
+const arm_cfft_instance_f32 arm_cfft_sR_f32_len16 = { 16 };
+const arm_cfft_instance_f32 arm_cfft_sR_f32_len32 = { 32 };
+const arm_cfft_instance_f32 arm_cfft_sR_f32_len64 = { 64 };
+const arm_cfft_instance_f32 arm_cfft_sR_f32_len128 = { 128 };
+const arm_cfft_instance_f32 arm_cfft_sR_f32_len256 = { 256 };
+const arm_cfft_instance_f32 arm_cfft_sR_f32_len512 = { 512 };
+
+static void bitReverse(float32_t *p, uint16_t length) {
+    uint16_t j = 0;
+    for (uint16_t i = 0; i < length; i++) {
+        if (i < j) {
+            float32_t re = p[2 * i];
+            float32_t im = p[2 * i + 1];
+            p[2 * i] = p[2 * j];
+            p[2 * i + 1] = p[2 * j + 1];
+            p[2 * j] = re;
+            p[2 * j + 1] = im;
+        }
+
+        uint16_t bit = length >> 1;
+        while (j & bit) {
+            j ^= bit;
+            bit >>= 1;
+        }
+        j |= bit;
+    }
+}
+
+// Radix-2 decimation in time; forward is unscaled and inverse scaled by 1/N,
+// like CMSIS. With bitReverseFlag cleared the output is left bit reversed.
+void arm_cfft_f32(const arm_cfft_instance_f32 *S, float32_t *p1, uint8_t ifftFlag, uint8_t bitReverseFlag) {
+    uint16_t length = S->fftLen;
+    double sign = ifftFlag ? 1.0 : -1.0;
+
+    bitReverse(p1, length);
+
+    for (uint16_t size = 2; size <= length; size <<= 1) {
+        uint16_t half = size >> 1;
+        for (uint16_t k = 0; k < half; k++) {
+            double angle = sign * 2.0 * M_PI * k / size;
+            float32_t wr = (float32_t)cos(angle);
+            float32_t wi = (float32_t)sin(angle);
+
+            for (uint16_t i = k; i < length; i += size) {
+                uint16_t j = i + half;
+                float32_t tr = wr * p1[2 * j] - wi * p1[2 * j + 1];
+                float32_t ti = wr * p1[2 * j + 1] + wi * p1[2 * j];
+                p1[2 * j] = p1[2 * i] - tr;
+                p1[2 * j + 1] = p1[2 * i + 1] - ti;
+                p1[2 * i] += tr;
+                p1[2 * i + 1] += ti;
+            }
+        }
+    }
+
+    if (ifftFlag) {
+        for (uint16_t i = 0; i < 2 * length; i++) {
+            p1[i] /= length;
+        }
+    }
+
+    if (!bitReverseFlag) {
+        bitReverse(p1, length);
+    }
+}
+
+arm_status arm_rfft_init_q15(arm_rfft_instance_q15 *S, uint32_t fftLenReal, uint32_t ifftFlagR, uint32_t bitReverseFlag) {
+    if (fftLenReal < 32 || fftLenReal > 8192 || (fftLenReal & (fftLenReal - 1)) != 0) {
+        return ARM_MATH_ARGUMENT_ERROR;
+    }
+
+    S->fftLenReal = fftLenReal;
+    S->ifftFlagR = ifftFlagR;
+    S->bitReverseFlagR = bitReverseFlag;
+    return ARM_MATH_SUCCESS;
+}
+
+static q15_t saturateQ15(int32_t value) {
+    return (q15_t)(value > 32767 ? 32767 : (value < -32768 ? -32768 : value));
+}
+
+// Twiddles are Q15 like the CMSIS tables, where 1.0 is 0x7FFF
+static int32_t twiddleQ15(double value) {
+    return saturateQ15((int32_t)lround(value * 32768));
+}
+
+/**
+ * Forward transform only, modelled on what CMSIS does to the numbers rather
+ * than on its code: a fftLenReal / 2 point complex FFT of the even and odd
+ * samples that halves both butterfly inputs at every radix-2 stage, then the
+ * split into the real spectrum, which halves once more. Every shift and every
+ * Q15 twiddle product truncates, as the arithmetic shifts in CMSIS do. The
+ * output is X[k] / fftLenReal in Q15, written as fftLenReal complex values.
+ */
+void arm_rfft_q15(const arm_rfft_instance_q15 *S, q15_t *pSrc, q15_t *pDst) {
+    static int32_t re[4096];
+    static int32_t im[4096];
+    uint32_t length = S->fftLenReal;
+    uint32_t half = length / 2;
+
+    uint32_t j = 0;
+    for (uint32_t i = 0; i < half; i++) {
+        re[j] = pSrc[2 * i];
+        im[j] = pSrc[2 * i + 1];
+
+        uint32_t bit = half >> 1;
+        while (j & bit) {
+            j ^= bit;
+            bit >>= 1;
+        }
+        j |= bit;
+    }
+
+    for (uint32_t size = 2; size <= half; size <<= 1) {
+        uint32_t step = size >> 1;
+        for (uint32_t k = 0; k < step; k++) {
+            int32_t wr = twiddleQ15(cos(2.0 * M_PI * k / size));
+            int32_t wi = twiddleQ15(-sin(2.0 * M_PI * k / size));
+
+            for (uint32_t i = k; i < half; i += size) {
+                uint32_t m = i + step;
+                int32_t ar = re[i] >> 1, ai = im[i] >> 1;
+                int32_t br = re[m] >> 1, bi = im[m] >> 1;
+                int32_t tr = (br * wr - bi * wi) >> 15;
+                int32_t ti = (br * wi + bi * wr) >> 15;
+                re[i] = ar + tr;
+                im[i] = ai + ti;
+                re[m] = ar - tr;
+                im[m] = ai - ti;
+            }
+        }
+    }
+
+    // X[k] = (Z[k] + Z*[-k]) / 2 + W^k (Z[k] - Z*[-k]) / 2j, halved
+    for (uint32_t k = 0; k <= half; k++) {
+        uint32_t a = k % half;
+        uint32_t b = (half - k) % half;
+        int32_t evenRe = re[a] + re[b];
+        int32_t evenIm = im[a] - im[b];
+        int32_t oddRe = im[a] + im[b];
+        int32_t oddIm = re[b] - re[a];
+        int32_t wr = twiddleQ15(cos(2.0 * M_PI * k / length));
+        int32_t wi = twiddleQ15(-sin(2.0 * M_PI * k / length));
+
+        int32_t xr = (evenRe + ((oddRe * wr - oddIm * wi) >> 15)) >> 2;
+        int32_t xi = (evenIm + ((oddRe * wi + oddIm * wr) >> 15)) >> 2;
+        pDst[2 * k] = saturateQ15(xr);
+        pDst[2 * k + 1] = saturateQ15(xi);
+        if (k > 0 && k < half) {
+            pDst[2 * (length - k)] = saturateQ15(xr);
+            pDst[2 * (length - k) + 1] = saturateQ15(-xi);
+        }
+    }
+}
+
+// Output is in 2.14 format, i.e. half the Q15 magnitude. Like CMSIS the sum
+// of squares drops to Q15 (>> 17) before the square root, so small
+// magnitudes come out in coarse steps: anything under 362 in is 0 out.
+void arm_cmplx_mag_q15(const q15_t *pSrc, q15_t *pDst, uint32_t numSamples) {
+    for (uint32_t i = 0; i < numSamples; i++) {
+        int32_t re = pSrc[2 * i];
+        int32_t im = pSrc[2 * i + 1];
+        uint32_t squares = (uint32_t)(re * re) + (uint32_t)(im * im);
+        pDst[i] = saturateQ15((int32_t)sqrt((double)(squares >> 17) * 32768));
+    }
+}
+
+void arm_cmplx_mag_f32(const float32_t *pSrc, float32_t *pDst, uint32_t numSamples) {
+    for (uint32_t i = 0; i < numSamples; i++) {
+        float32_t re = pSrc[2 * i];
+        float32_t im = pSrc[2 * i + 1];
+        pDst[i] = sqrtf(re * re + im * im);
+    }
+}
+
+void arm_max_f32(const float32_t *pSrc, uint32_t blockSize, float32_t *pResult, uint32_t *pIndex) {
+    float32_t maximum = pSrc[0];
+    uint32_t index = 0;
+
+    for (uint32_t i = 1; i < blockSize; i++) {
+        if (pSrc[i] > maximum) {
+            maximum = pSrc[i];
+            index = i;
+        }
+    }
+
+    *pResult = maximum;
+    *pIndex = index;
+}
+
+void arm_mean_f32(const float32_t *pSrc, uint32_t blockSize, float32_t *pResult) {
+    float32_t sum = 0;
+    for (uint32_t i = 0; i < blockSize; i++) {
+        sum += pSrc[i];
+    }
+
+    *pResult = sum / (float32_t)blockSize;
+}
+
+float32_t arm_cos_f32(float32_t x) {
+    return cosf(x);
+}
+
+float32_t arm_sin_f32(float32_t x) {
+    return sinf(x);
+}
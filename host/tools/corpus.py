@@ -0,0 +1,224 @@
+#!/usr/bin/env python3
+"""
+Generate the replay corpus (see replay.py)
+
+    host/tools/corpus.py [--output DIR] [--seconds N] [NAME ...]
+
+Writes one 44.1 kHz 16-bit mono WAV per genre, synthesised from a fixed seed
+so every checkout gets the same audio and the same beats. The goggles never
+hear a clean mix, so every clip sits on a bed of crowd noise, and the ones
+with drums have a breakdown halfway through to make the noise floor and the
+gain find their way back.
+
+    house       124 BPM four on the floor, clap, open hats, rolling bass
+    hiphop      90 BPM swung kick and snare, 16th hats, sub bass
+    dnb         174 BPM two-step break, fast hats, detuned bass
+    rock        120 BPM kick and snare under distorted power chords
+    ambient     pads and swells, no beat at all
+
+Recordings dropped into the same directory are replayed along with these.
+Only the standard library is used.
+"""
+
+import argparse
+import array
+import math
+import os
+import random
+import wave
+
+RATE = 44100
+SECONDS = 16
+
+
+class Mix:
+    def __init__(self, seconds, seed):
+        self.samples = [0.0] * int(seconds * RATE)
+        self.random = random.Random(seed)
+
+    def add(self, start, values, gain=1.0):
+        first = int(start * RATE)
+        for i, value in enumerate(values, first):
+            if i >= len(self.samples):
+                break
+            if i >= 0:
+                self.samples[i] += gain * value
+
+    def noise(self, length):
+        return [self.random.uniform(-1.0, 1.0) for _ in range(length)]
+
+    def kick(self, start, gain=1.0):
+        values = []
+        phase = 0.0
+        for i in range(int(0.35 * RATE)):
+            t = i / RATE
+            phase += 2 * math.pi * (45 + 110 * math.exp(-t * 30)) / RATE
+            values.append(math.exp(-t * 12) * math.sin(phase))
+        self.add(start, values, gain)
+
+    def snare(self, start, gain=1.0):
+        noise = self.noise(int(0.25 * RATE))
+        values = [(0.7 * n * math.exp(-i / RATE * 25) + 0.5 * math.sin(2 * math.pi * 190 * i / RATE) *
+                   math.exp(-i / RATE * 40)) for i, n in enumerate(noise)]
+        self.add(start, values, gain)
+
+    def hat(self, start, gain=1.0, decay=120.0):
+        noise = self.noise(int(min(0.3, 6.0 / decay) * RATE) + 1)
+        # First difference, for something that is mostly highs
+        values = [(noise[i + 1] - noise[i]) * math.exp(-i / RATE * decay) for i in range(len(noise) - 1)]
+        self.add(start, values, gain)
+
+    def tone(self, start, length, frequency, gain=1.0, harmonics=3, detune=0.0, drive=0.0):
+        values = []
+        for i in range(int(length * RATE)):
+            t = i / RATE
+            value = 0.0
+            for h in range(1, harmonics + 1):
+                value += math.sin(2 * math.pi * frequency * h * t) / h
+                if detune:
+                    value += math.sin(2 * math.pi * frequency * (1 + detune) * h * t) / h
+            if drive:
+                value = math.tanh(drive * value)
+            # 5 ms attack and release, so the notes themselves do not click
+            value *= min(1.0, t / 0.005, (length - t) / 0.005)
+            values.append(value)
+        self.add(start, values, gain)
+
+    def crowd(self, gain):
+        # Low passed noise with a slow swell
+        level = 0.0
+        for i in range(len(self.samples)):
+            level += 0.05 * (self.random.uniform(-1.0, 1.0) - level)
+            self.samples[i] += gain * level * (1.0 + 0.3 * math.sin(2 * math.pi * 0.2 * i / RATE))
+
+    def write(self, path):
+        peak = max(max(self.samples), -min(self.samples), 1e-9)
+        pcm = array.array("h", (int(round(32767 * 0.8 * s / peak)) for s in self.samples))
+        with wave.open(path, "wb") as output:
+            output.setnchannels(1)
+            output.setsampwidth(2)
+            output.setframerate(RATE)
+            output.writeframes(pcm.tobytes())
+
+
+def beats(seconds, bpm):
+    """Beat start times, skipping the breakdown"""
+    beat = 60.0 / bpm
+    times = []
+    for n in range(int(seconds / beat)):
+        time = n * beat
+        if not 0.45 * seconds <= time < 0.6 * seconds:
+            times.append((n, time))
+    return times
+
+
+def house(mix, seconds):
+    beat = 60.0 / 124
+    notes = [55.0, 55.0, 65.4, 49.0]
+    for n, time in beats(seconds, 124):
+        mix.kick(time)
+        if n % 2 == 1:
+            mix.snare(time, 0.5)
+        mix.hat(time + beat / 2, 0.3, 25)
+        mix.tone(time + beat / 2, beat / 2, notes[(n // 4) % 4], 0.35)
+    for bar in range(int(seconds / (4 * beat))):
+        mix.tone(bar * 4 * beat, 4 * beat, 220.0 * (1.5 if bar % 2 else 1.0), 0.05, harmonics=2, detune=0.004)
+
+
+def hiphop(mix, seconds):
+    beat = 60.0 / 90
+    swing = beat / 2 * 1.33
+    for n, time in beats(seconds, 90):
+        if n % 4 in (0, 2):
+            mix.kick(time)
+        if n % 4 == 2:
+            mix.kick(time + swing, 0.7)
+        if n % 2 == 1:
+            mix.snare(time, 0.7)
+        for sixteenth in range(4):
+            offset = sixteenth * beat / 4 + (beat / 12 if sixteenth % 2 else 0)
+            mix.hat(time + offset, 0.15)
+        if n % 4 == 0:
+            mix.tone(time, 2 * beat, 41.2, 0.4, harmonics=1)
+
+
+def dnb(mix, seconds):
+    beat = 60.0 / 174
+    for n, time in beats(seconds, 174):
+        if n % 4 == 0:
+            mix.kick(time)
+        if n % 4 == 2:
+            mix.kick(time + beat / 2, 0.8)
+        if n % 2 == 1:
+            mix.snare(time, 0.8)
+        mix.hat(time, 0.12)
+        mix.hat(time + beat / 2, 0.12)
+        if n % 8 == 0:
+            mix.tone(time, 8 * beat, 43.7 if (n // 8) % 2 else 36.7, 0.3, harmonics=4, detune=0.01)
+
+
+def rock(mix, seconds):
+    beat = 60.0 / 120
+    chords = [82.4, 82.4, 110.0, 98.0]
+    for n, time in beats(seconds, 120):
+        if n % 2 == 0:
+            mix.kick(time)
+        else:
+            mix.snare(time, 0.9)
+        mix.hat(time, 0.1, 60)
+        mix.hat(time + beat / 2, 0.1, 60)
+        for eighth in range(2):
+            root = chords[(n // 4) % 4]
+            mix.tone(time + eighth * beat / 2, beat / 2, root, 0.12, harmonics=3, detune=0.5, drive=4.0)
+
+
+def ambient(mix, seconds):
+    chords = [(220.0, 277.2, 329.6), (196.0, 246.9, 293.7), (174.6, 220.0, 261.6)]
+    length = 4.0
+    for i in range(int(seconds / length) + 1):
+        for frequency in chords[i % len(chords)]:
+            mix.tone(i * length - 0.5, length + 1.0, frequency, 0.08, harmonics=2, detune=0.003)
+    # Swells of filtered noise, nothing with an edge to it
+    level = 0.0
+    swell = [0.0] * len(mix.samples)
+    for i in range(len(swell)):
+        level += 0.02 * (mix.random.uniform(-1.0, 1.0) - level)
+        swell[i] = level * (0.5 - 0.5 * math.cos(2 * math.pi * i / RATE / 8.0))
+    mix.add(0, swell, 0.6)
+
+
+GENRES = {
+    "house": house,
+    "hiphop": hiphop,
+    "dnb": dnb,
+    "rock": rock,
+    "ambient": ambient,
+}
+
+
+def generate(name, path, seconds=SECONDS):
+    mix = Mix(seconds, sorted(GENRES).index(name) + 1)
+    GENRES[name](mix, seconds)
+    mix.crowd(0.15)
+    mix.write(path)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Generate the replay corpus")
+    parser.add_argument("--output", default=os.path.join(os.path.dirname(__file__), "..", "corpus"))
+    parser.add_argument("--seconds", type=float, default=SECONDS)
+    parser.add_argument("names", nargs="*", metavar="NAME", help=", ".join(sorted(GENRES)))
+    arguments = parser.parse_args()
+    for name in arguments.names:
+        if name not in GENRES:
+            parser.error("no genre called %s" % name)
+
+    os.makedirs(arguments.output, exist_ok=True)
+    for name in arguments.names or sorted(GENRES):
+        path = os.path.join(arguments.output, name + ".wav")
+        generate(name, path, arguments.seconds)
+        print(path)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,214 @@
+#!/usr/bin/env python3
+"""
+Replay the corpus through the simulator and compare against baselines
+
+    host/tools/replay.py [--corpus DIR] [--baselines FILE] [--repeat N]
+                         [--tolerance PERCENT] [--update] [CLIP ...]
+
+Every WAV in the corpus directory (default host/corpus, generated by
+corpus.py when missing) goes through goggles-sim --report: the firmware's own
+analysis, Matrix and Strip at SAMPLE_RATE and the microphone's ADC range, on
+virtual time. Per clip this collects
+
+    beats       every onset the analysis published, in virtual time
+    pixels      a digest of everything sent to the matrix and to the strip
+    timing      mean wall-clock us per run of each stage (Profile.h) and
+                task, and the task time per second of audio (busy us/s),
+                the best of --repeat runs
+
+Virtual time makes beats and pixels exact, so any change to them shows up.
+Timing is only compared against baselines recorded on the same machine, and
+only a slowdown past --tolerance counts. Beat changes and slowdowns fail the
+run; a pixel change is reported but does not, as plenty of work means to
+change what is drawn. --update records the current results as the baselines.
+"""
+
+import argparse
+import glob
+import json
+import os
+import platform
+import subprocess
+import sys
+import tempfile
+
+import corpus
+
+HOST = os.path.normpath(os.path.join(os.path.dirname(os.path.abspath(__file__)), ".."))
+STAGES = ["capture", "fft", "render", "show"]
+# Onsets this close to a missing one count as moved rather than new
+MOVE_WINDOW_US = 50000
+
+
+def machine():
+    return "%s %s" % (platform.node(), platform.machine())
+
+
+def simulate(simulator, clip):
+    with tempfile.NamedTemporaryFile(suffix=".json") as report:
+        subprocess.run([simulator, "--input", clip, "--report", report.name], check=True,
+                       stderr=subprocess.DEVNULL)
+        run = json.load(open(report.name))
+
+    seconds = run["seconds"]
+    return {
+        "seconds": seconds,
+        "overruns": run["overruns"],
+        "onsets": [onset[0] for onset in run["onsets"]],
+        "matrix": run["matrix"]["digest"],
+        "strip": run["strip"]["digest"],
+        "stages": dict((name, run["stages"][name]["mean_us"]) for name in STAGES),
+        "tasks": dict((name, task["mean_us"]) for name, task in run["tasks"].items()),
+        "busy_us_per_s": sum(task["runs"] * task["mean_us"] for task in run["tasks"].values()) / seconds,
+    }
+
+
+def merge(result, current, clip):
+    """Keep beats and pixels from the first run and the best timing of all"""
+    if result is None:
+        return current
+
+    if (current["onsets"], current["matrix"], current["strip"]) != \
+            (result["onsets"], result["matrix"], result["strip"]):
+        sys.stderr.write("%s: runs disagree, something depends on more than virtual time\n" % clip)
+    for group in ("stages", "tasks"):
+        for name, mean in current[group].items():
+            result[group][name] = min(result[group].get(name, mean), mean)
+    result["busy_us_per_s"] = min(result["busy_us_per_s"], current["busy_us_per_s"])
+    return result
+
+
+def compareBeats(baseline, current):
+    """Onsets added, removed and moved between two sorted lists of times"""
+    previous = list(baseline)
+    added = []
+    for time in current:
+        if time in previous:
+            previous.remove(time)
+        else:
+            added.append(time)
+
+    moved = 0
+    for time in list(added):
+        near = [old for old in previous if abs(old - time) <= MOVE_WINDOW_US]
+        if near:
+            previous.remove(min(near, key=lambda old: abs(old - time)))
+            added.remove(time)
+            moved += 1
+
+    return len(added), len(previous), moved
+
+
+def change(baseline, current):
+    return 100.0 * (current - baseline) / baseline if baseline > 0 else 0.0
+
+
+def compare(name, baseline, current, tolerance, timing):
+    """Print one clip's line, return whether it passes"""
+    failures = []
+    line = ["%-10s %4d onsets" % (name, len(current["onsets"]))]
+
+    if baseline is None:
+        line.append("no baseline")
+    else:
+        added, removed, moved = compareBeats(baseline["onsets"], current["onsets"])
+        if added or removed or moved:
+            line.append("beats +%d -%d ~%d" % (added, removed, moved))
+            failures.append("beats")
+        else:
+            line.append("beats same")
+
+        changed = [output for output in ("matrix", "strip") if baseline[output] != current[output]]
+        line.append("pixels " + ("changed (%s)" % ", ".join(changed) if changed else "same"))
+
+    for stage in ("fft", "render", "show"):
+        text = "%s %.2fus" % (stage, current["stages"][stage])
+        if baseline is not None and timing:
+            difference = change(baseline["stages"][stage], current["stages"][stage])
+            text += " %+.0f%%" % difference
+            if difference > tolerance:
+                failures.append(stage)
+        line.append(text)
+
+    text = "busy %.0fus/s" % current["busy_us_per_s"]
+    if baseline is not None and timing:
+        difference = change(baseline["busy_us_per_s"], current["busy_us_per_s"])
+        text += " %+.0f%%" % difference
+        if difference > tolerance:
+            failures.append("busy")
+    line.append(text)
+
+    if current["overruns"]:
+        line.append("%d overruns" % current["overruns"])
+        failures.append("overruns")
+
+    line.append("FAIL (%s)" % ", ".join(failures) if failures else "ok")
+    print("  ".join(line))
+    return not failures
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Replay the corpus and compare against baselines")
+    parser.add_argument("--corpus", default=os.path.join(HOST, "corpus"))
+    parser.add_argument("--baselines", help="default CORPUS/baselines.json")
+    parser.add_argument("--simulator", default=os.path.join(HOST, "goggles-sim"))
+    parser.add_argument("--repeat", type=int, default=5, help="runs per clip, the best timing counts")
+    parser.add_argument("--tolerance", type=float, default=25.0, help="slowdown in percent that fails")
+    parser.add_argument("--update", action="store_true", help="record the results as the new baselines")
+    parser.add_argument("clips", nargs="*", metavar="CLIP", help="names in the corpus, default all")
+    arguments = parser.parse_args()
+
+    if not os.path.exists(arguments.simulator):
+        parser.error("%s is not built, run make -C host" % arguments.simulator)
+
+    for name in corpus.GENRES:
+        path = os.path.join(arguments.corpus, name + ".wav")
+        if not os.path.exists(path):
+            os.makedirs(arguments.corpus, exist_ok=True)
+            sys.stderr.write("generating %s\n" % path)
+            corpus.generate(name, path)
+
+    baselinesPath = arguments.baselines or os.path.join(arguments.corpus, "baselines.json")
+    baselines = {"machine": machine(), "clips": {}}
+    if os.path.exists(baselinesPath):
+        baselines = json.load(open(baselinesPath))
+
+    timing = baselines["machine"] == machine()
+    if not timing and not arguments.update:
+        sys.stderr.write("timing baselines are from %s, not compared; --update on this machine first\n" %
+                         baselines["machine"])
+
+    clips = sorted(glob.glob(os.path.join(arguments.corpus, "*.wav")))
+    names = [os.path.splitext(os.path.basename(clip))[0] for clip in clips]
+    for name in arguments.clips:
+        if name not in names:
+            parser.error("no %s.wav in %s" % (name, arguments.corpus))
+
+    # Round robin, so the host getting busier for a while does not land on
+    # one clip's runs alone
+    results = {}
+    for _ in range(arguments.repeat):
+        for clip, name in zip(clips, names):
+            if not arguments.clips or name in arguments.clips:
+                results[name] = merge(results.get(name), simulate(arguments.simulator, clip), clip)
+
+    passed = True
+    for name in sorted(results):
+        passed &= compare(name, baselines["clips"].get(name), results[name], arguments.tolerance, timing)
+
+    if arguments.update:
+        if not timing:
+            # Timing from another machine means nothing here, start over
+            baselines = {"machine": machine(), "clips": {}}
+        baselines["clips"].update(results)
+        with open(baselinesPath, "w") as output:
+            json.dump(baselines, output, indent=1, sort_keys=True)
+            output.write("\n")
+        sys.stderr.write("baselines written to %s\n" % baselinesPath)
+        return 0
+
+    return 0 if passed else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
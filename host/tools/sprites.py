@@ -0,0 +1,210 @@
+#!/usr/bin/env python3
+"""
+Build graphics.h from bitmaps/*.png
+
+    host/tools/sprites.py [--bitmaps DIR] [--output FILE]
+
+Every PNG becomes a Sprite named after the file (eye-left.png -> EYE_LEFT),
+stored in whichever format of Sprite.h is smaller:
+
+    SPRITE_RAW      3 bytes a pixel
+    SPRITE_INDEXED  a palette of up to SPRITE_MAX_COLORS, then runs of one
+                    palette index; black, if there is any, is always index 0
+
+An image that is a mirror of one already emitted (left/right eye frames, the
+colour swirl) reuses that data with SPRITE_MIRROR_X / _Y set instead of
+storing it again.
+
+Only the standard library is used, so PNGs are decoded here: 8-bit truecolour,
+greyscale or palette, with or without alpha, non-interlaced. Fully
+transparent pixels are black.
+"""
+
+import argparse
+import glob
+import os
+import struct
+import sys
+import zlib
+
+MAX_COLORS = 64
+RAW = 0
+INDEXED = 1
+MIRROR_X = 1
+MIRROR_Y = 2
+
+
+def paeth(a, b, c):
+    p = a + b - c
+    pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+    if pa <= pb and pa <= pc:
+        return a
+    return b if pb <= pc else c
+
+
+def read_png(path):
+    with open(path, 'rb') as f:
+        data = f.read()
+    if data[:8] != b'\x89PNG\r\n\x1a\n':
+        raise ValueError('not a PNG')
+
+    position = 8
+    idat = b''
+    plte = b''
+    trns = b''
+    header = None
+    while position < len(data):
+        length, kind = struct.unpack('>I4s', data[position:position + 8])
+        body = data[position + 8:position + 8 + length]
+        position += 12 + length
+        if kind == b'IHDR':
+            header = struct.unpack('>IIBBBBB', body)
+        elif kind == b'PLTE':
+            plte = body
+        elif kind == b'tRNS':
+            trns = body
+        elif kind == b'IDAT':
+            idat += body
+        elif kind == b'IEND':
+            break
+
+    width, height, depth, color_type, _, _, interlace = header
+    if depth != 8 or interlace != 0:
+        raise ValueError('only 8-bit non-interlaced PNGs are supported')
+    channels = {0: 1, 2: 3, 3: 1, 4: 2, 6: 4}[color_type]
+
+    raw = zlib.decompress(idat)
+    stride = width * channels
+    previous = bytearray(stride)
+    pixels = []
+    offset = 0
+    for _ in range(height):
+        kind = raw[offset]
+        line = bytearray(raw[offset + 1:offset + 1 + stride])
+        offset += 1 + stride
+        for i in range(stride):
+            a = line[i - channels] if i >= channels else 0
+            b = previous[i]
+            c = previous[i - channels] if i >= channels else 0
+            if kind == 1:
+                line[i] = (line[i] + a) & 0xFF
+            elif kind == 2:
+                line[i] = (line[i] + b) & 0xFF
+            elif kind == 3:
+                line[i] = (line[i] + (a + b) // 2) & 0xFF
+            elif kind == 4:
+                line[i] = (line[i] + paeth(a, b, c)) & 0xFF
+        previous = line
+
+        for x in range(width):
+            p = line[x * channels:(x + 1) * channels]
+            if color_type == 0:
+                rgb, alpha = (p[0], p[0], p[0]), 255
+            elif color_type == 2:
+                rgb, alpha = tuple(p), 255
+            elif color_type == 3:
+                rgb = tuple(plte[p[0] * 3:p[0] * 3 + 3])
+                alpha = trns[p[0]] if p[0] < len(trns) else 255
+            elif color_type == 4:
+                rgb, alpha = (p[0], p[0], p[0]), p[1]
+            else:
+                rgb, alpha = tuple(p[:3]), p[3]
+            pixels.append(rgb if alpha > 0 else (0, 0, 0))
+
+    return width, height, pixels
+
+
+def mirrored(pixels, width, height, flags):
+    out = []
+    for y in range(height):
+        sy = height - 1 - y if flags & MIRROR_Y else y
+        for x in range(width):
+            sx = width - 1 - x if flags & MIRROR_X else x
+            out.append(pixels[sy * width + sx])
+    return out
+
+
+def encode(width, height, pixels):
+    raw = [width, height, RAW] + [c for p in pixels for c in p]
+
+    counts = {}
+    for p in pixels:
+        counts[p] = counts.get(p, 0) + 1
+    if len(counts) > MAX_COLORS:
+        return raw
+
+    palette = sorted(counts, key=lambda p: (p != (0, 0, 0), -counts[p], p))
+    index = {p: i for i, p in enumerate(palette)}
+    packed = len(palette) <= 16
+    longest = 16 if packed else 256
+
+    runs = []
+    i = 0
+    while i < len(pixels):
+        length = 1
+        while i + length < len(pixels) and length < longest and pixels[i + length] == pixels[i]:
+            length += 1
+        if packed:
+            runs.append(((length - 1) << 4) | index[pixels[i]])
+        else:
+            runs += [length - 1, index[pixels[i]]]
+        i += length
+
+    indexed = [width, height, INDEXED, len(palette)] + [c for p in palette for c in p] + runs
+    return indexed if len(indexed) < len(raw) else raw
+
+
+def main():
+    root = os.path.normpath(os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', '..'))
+    parser = argparse.ArgumentParser(description='Build graphics.h from bitmaps/*.png')
+    parser.add_argument('--bitmaps', default=os.path.join(root, 'bitmaps'))
+    parser.add_argument('--output', default=os.path.join(root, 'graphics.h'))
+    args = parser.parse_args()
+
+    emitted = []
+    lines = []
+    before = after = 0
+    for path in sorted(glob.glob(os.path.join(args.bitmaps, '*.png'))):
+        name = os.path.splitext(os.path.basename(path))[0].upper().replace('-', '_')
+        width, height, pixels = read_png(path)
+        before += width * height * 3
+
+        source = None
+        for other, (w, h, p) in emitted:
+            if (w, h) != (width, height):
+                continue
+            for flags in (0, MIRROR_X, MIRROR_Y, MIRROR_X | MIRROR_Y):
+                if mirrored(p, w, h, flags) == pixels:
+                    source = (other, flags)
+                    break
+            if source:
+                break
+
+        if source:
+            names = ['SPRITE_MIRROR_X'] * bool(source[1] & MIRROR_X) + ['SPRITE_MIRROR_Y'] * bool(source[1] & MIRROR_Y)
+            lines.append('static const Sprite %s = { %s_DATA, %s };\n' % (name, source[0], ' | '.join(names) or '0'))
+            continue
+
+        data = encode(width, height, pixels)
+        after += len(data)
+        emitted.append((name, (width, height, pixels)))
+
+        lines.append('static const uint8_t PROGMEM %s_DATA[] = {' % name)
+        for i in range(0, len(data), 16):
+            lines.append('    ' + ','.join('0x%02x' % b for b in data[i:i + 16]) + ',')
+        lines[-1] = lines[-1].rstrip(',')
+        lines.append('};')
+        lines.append('static const Sprite %s = { %s_DATA, 0 };\n' % (name, name))
+
+    with open(args.output, 'w') as f:
+        f.write('// Generated by host/tools/sprites.py from bitmaps/*.png, do not edit\n')
+        f.write('// %d bytes of sprite data for %d bytes of pixels\n\n' % (after, before))
+        f.write('#ifndef _GFX_H_\n#define _GFX_H_\n\n#include "Sprite.h"\n\n')
+        f.write('\n'.join(lines))
+        f.write('\n#endif\n')
+
+    sys.stderr.write('%s: %d bytes of sprite data for %d bytes of pixels\n' % (args.output, after, before))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,265 @@
+#!/usr/bin/env python3
+"""
+Decode the binary telemetry stream (see Telemetry.h) into CSV
+
+    host/tools/telemetry.py SOURCE [--output DIR] [--rate DIGIT] [--plot]
+
+SOURCE is a file written by goggles-sim --serial, or the goggles' serial
+device (e.g. /dev/ttyACM0), which is read until interrupted. --rate sends the
+digit that selects the report rate first, e.g. 4 for 10 reports a second.
+
+Writes to DIR (default telemetry/):
+
+    spectrum.csv    time_us, sequence, bin0 .. binN
+    bass.csv        time_us, sequence, peak_hz, peak, then the level at each
+                    bass bin, headed by its frequency in Hz
+    onsets.csv      time_us, strength, bands
+    timing.csv      time_us, kind, name, runs, mean_us, worst_us,
+                    mean_late_us, worst_late_us, missed, dropped,
+                    mean_cycles, worst_cycles
+                    (means are over the interval since the previous report;
+                    stages are timed in CPU cycles, which from the goggles
+                    are the M0's own cycle counts)
+    duty.csv        time_us, busy_percent, idle_percent, other_percent
+                    (over the interval since the previous report)
+    summary.png     with --plot, if matplotlib is installed
+
+Each timing report is also summarised on stderr, which is the part to watch
+while tuning live.
+"""
+
+import argparse
+import csv
+import os
+import struct
+import sys
+
+SPECTRUM = 1
+ONSET = 2
+TIMING = 3
+BASS = 4
+
+LEVEL_SCALE = 256.0
+RATES = [0, 1, 2, 5, 10, 20, 25, 50, 100, 125]
+
+# Registration order in goggles.ino, and Profile.h
+TASK_NAMES = ["analysis", "matrix", "strip", "telemetry"]
+STAGE_NAMES = ["capture", "fft", "render", "show", "spectrum"]
+
+# HAL_CPU_CLOCK, for stage cycles in us
+CYCLES_PER_US = 48.0
+
+
+def crc16(data):
+    crc = 0xFFFF
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else crc << 1
+            crc &= 0xFFFF
+    return crc
+
+
+def cobs_decode(data):
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        if code == 0 or i + code > len(data):
+            return None
+        out += data[i + 1:i + code]
+        i += code
+        if code < 0xFF and i < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+def packets(stream):
+    """Yield decoded packets with a good CRC; count the bad ones"""
+    buffer = bytearray()
+    packets.bad = 0
+    while True:
+        chunk = stream.read(1 if stream.isatty() else 65536)
+        if not chunk:
+            return
+        buffer += chunk
+        while True:
+            end = buffer.find(0)
+            if end < 0:
+                break
+            frame = bytes(buffer[:end])
+            del buffer[:end + 1]
+            if not frame:
+                continue
+            packet = cobs_decode(frame)
+            if packet is None or len(packet) < 3 or crc16(packet[:-2]) != struct.unpack("<H", packet[-2:])[0]:
+                packets.bad += 1
+                continue
+            yield packet[0], packet[1:-2]
+
+
+def name(names, index):
+    return names[index] if index < len(names) else "%d" % index
+
+
+class Decoder:
+    def __init__(self, output):
+        os.makedirs(output, exist_ok=True)
+        self.files = {}
+        self.writers = {}
+        for kind in ("spectrum", "bass", "onsets", "timing", "duty"):
+            self.files[kind] = open(os.path.join(output, kind + ".csv"), "w", newline="")
+            self.writers[kind] = csv.writer(self.files[kind])
+        self.writers["onsets"].writerow(["time_us", "strength", "bands"])
+        self.writers["timing"].writerow(["time_us", "kind", "name", "runs", "mean_us", "worst_us",
+                                         "mean_late_us", "worst_late_us", "missed", "dropped",
+                                         "mean_cycles", "worst_cycles"])
+        self.writers["duty"].writerow(["time_us", "busy_percent", "idle_percent", "other_percent"])
+        self.spectrumHeader = False
+        self.bassHeader = False
+        self.previous = {}
+        self.spectra = []
+        self.stageMeans = {}
+
+    def close(self):
+        for file in self.files.values():
+            file.close()
+
+    def spectrum(self, payload):
+        sequence, time, bins = struct.unpack_from("<IIB", payload)
+        levels = [value / LEVEL_SCALE for value in struct.unpack_from("<%dH" % bins, payload, 9)]
+        if not self.spectrumHeader:
+            self.writers["spectrum"].writerow(["time_us", "sequence"] + ["bin%d" % i for i in range(bins)])
+            self.spectrumHeader = True
+        self.writers["spectrum"].writerow([time, sequence] + ["%.4f" % level for level in levels])
+        self.spectra.append((time, levels))
+
+    def bass(self, payload):
+        sequence, time, peak, peakLevel, width, bins = struct.unpack_from("<IIHHHB", payload)
+        levels = [value / LEVEL_SCALE for value in struct.unpack_from("<%dH" % bins, payload, 15)]
+        if not self.bassHeader:
+            self.writers["bass"].writerow(["time_us", "sequence", "peak_hz", "peak"] +
+                                          ["%.1f" % (i * width / 256.0) for i in range(bins)])
+            self.bassHeader = True
+        self.writers["bass"].writerow([time, sequence, "%.2f" % (peak / 16.0), "%.4f" % (peakLevel / LEVEL_SCALE)] +
+                                      ["%.4f" % level for level in levels])
+
+    def onset(self, payload):
+        time, strength, bands = struct.unpack_from("<IHB", payload)
+        self.writers["onsets"].writerow([time, "%.3f" % (strength / LEVEL_SCALE), bands])
+
+    def interval(self, key, runs, total, lateness):
+        previous = self.previous.get(key, (0, 0, 0))
+        self.previous[key] = (runs, total, lateness)
+        count = runs - previous[0]
+        if count <= 0:
+            return 0.0, 0.0
+        # 32 bit totals, so differences modulo 2^32
+        return ((total - previous[1]) & 0xFFFFFFFF) / count, ((lateness - previous[2]) & 0xFFFFFFFF) / count
+
+    def duty(self, time, elapsed, busy, idle):
+        previous = self.previous.get("duty")
+        self.previous["duty"] = (elapsed, busy, idle)
+        if previous is None:
+            return ""
+        # 32 bit counters, so differences modulo 2^32
+        span = (elapsed - previous[0]) & 0xFFFFFFFF
+        if span == 0:
+            return ""
+        busy = 100.0 * ((busy - previous[1]) & 0xFFFFFFFF) / span
+        # The simulator sleeps through every tick, so it can add up to over 100
+        idle = min(100.0 * ((idle - previous[2]) & 0xFFFFFFFF) / span, 100 - busy)
+        self.writers["duty"].writerow([time, "%.2f" % busy, "%.2f" % idle, "%.2f" % (100 - busy - idle)])
+        return "  busy %.1f%% idle %.1f%%" % (busy, idle)
+
+    def timing(self, payload):
+        time, overruns, dropped, elapsed, busy, idle, tasks = struct.unpack_from("<6IB", payload)
+        offset = 25
+        line = []
+        for i in range(tasks):
+            runs, total, worst, lateness, worstLate, missed, dropped_ = struct.unpack_from("<7I", payload, offset)
+            offset += 28
+            mean, meanLate = self.interval(("task", i), runs, total, lateness)
+            self.writers["timing"].writerow([time, "task", name(TASK_NAMES, i), runs, "%.2f" % mean, worst,
+                                             "%.2f" % meanLate, worstLate, missed, dropped_, "", ""])
+            line.append("%s %.0f/%dus late %d" % (name(TASK_NAMES, i), mean, worst, worstLate))
+
+        stages = payload[offset]
+        offset += 1
+        stageLine = []
+        for i in range(stages):
+            count, total, worst = struct.unpack_from("<3I", payload, offset)
+            offset += 12
+            mean, _ = self.interval(("stage", i), count, total, 0)
+            self.writers["timing"].writerow([time, "stage", name(STAGE_NAMES, i), count,
+                                             "%.2f" % (mean / CYCLES_PER_US), "%.0f" % (worst / CYCLES_PER_US),
+                                             "", "", "", "", "%.0f" % mean, worst])
+            self.stageMeans.setdefault(name(STAGE_NAMES, i), []).append((time, mean / CYCLES_PER_US))
+            stageLine.append("%s %.0f" % (name(STAGE_NAMES, i), mean))
+
+        duty = self.duty(time, elapsed, busy, idle)
+        for file in self.files.values():
+            file.flush()
+        sys.stderr.write("%9.3f s  %s  overruns %d  dropped %d%s\n" % (time / 1e6, "  ".join(line), overruns,
+                                                                      dropped, duty))
+        sys.stderr.write("%9s    cycles  %s\n" % ("", "  ".join(stageLine)))
+
+    def plot(self, path):
+        try:
+            import matplotlib
+            matplotlib.use("Agg")
+            import matplotlib.pyplot as pyplot
+        except ImportError:
+            sys.stderr.write("matplotlib is not installed, no plot\n")
+            return
+
+        figure, (top, bottom) = pyplot.subplots(2, 1, figsize=(10, 7), sharex=True)
+        if self.spectra:
+            times = [time / 1e6 for time, _ in self.spectra]
+            levels = list(zip(*[levels for _, levels in self.spectra]))
+            top.imshow(levels, aspect="auto", origin="lower", extent=(times[0], times[-1], 0, len(levels)))
+            top.set_ylabel("bin")
+        for stage, values in self.stageMeans.items():
+            bottom.plot([time / 1e6 for time, _ in values], [mean for _, mean in values], label=stage)
+        bottom.set_xlabel("s")
+        bottom.set_ylabel("mean us")
+        bottom.legend()
+        figure.savefig(path)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decode goggles telemetry into CSV")
+    parser.add_argument("source")
+    parser.add_argument("--output", default="telemetry")
+    parser.add_argument("--rate", type=int, choices=range(len(RATES)),
+                        help="rate digit to send first: " + ", ".join("%d=%d/s" % r for r in enumerate(RATES)))
+    parser.add_argument("--plot", action="store_true")
+    arguments = parser.parse_args()
+
+    stream = open(arguments.source, "r+b" if arguments.rate is not None else "rb", buffering=0)
+    if stream.isatty():
+        import termios
+        import tty
+        tty.setraw(stream.fileno(), termios.TCSANOW)
+    if arguments.rate is not None:
+        stream.write(str(arguments.rate).encode())
+
+    decoder = Decoder(arguments.output)
+    handlers = {SPECTRUM: decoder.spectrum, ONSET: decoder.onset, TIMING: decoder.timing, BASS: decoder.bass}
+    try:
+        for kind, payload in packets(stream):
+            if kind in handlers:
+                handlers[kind](payload)
+    except KeyboardInterrupt:
+        pass
+    finally:
+        decoder.close()
+
+    if packets.bad:
+        sys.stderr.write("%d corrupt packets skipped\n" % packets.bad)
+    if arguments.plot:
+        decoder.plot(os.path.join(arguments.output, "summary.png"))
+
+
+if __name__ == "__main__":
+    main()